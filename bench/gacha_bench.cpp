@@ -0,0 +1,484 @@
+// Benchmark jalur panas GachaSystem (Google Benchmark)
+// Hasil JSON untuk dibandingkan antar rilis:
+//   gacha_bench --benchmark_out=bench_results.json --benchmark_out_format=json
+// atau lewat target CMake: cmake --build <build> --target bench_json
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "banner_config.h"
+#include "banner_registry.h"
+#include "gacha_async.h"
+#include "gacha_server.h"
+#include "gacha_system.h"
+#include "pull_analytics.h"
+#include "pull_audit.h"
+#include "pull_scheduler.h"
+#include "result_renderer.h"
+
+namespace {
+
+// Katalog dengan jumlah karakter tertentu (rasio rarity mirip banner asli)
+std::vector<Character> makeCatalog(int64_t characterCount) {
+    const Rarity rarities[] = { RARITY_SSR, RARITY_SR, RARITY_R, RARITY_R };
+    std::vector<Character> characters(static_cast<size_t>(characterCount));
+    for (int64_t i = 0; i < characterCount; i++) {
+        Character& character = characters[static_cast<size_t>(i)];
+        character.name = "Char" + std::to_string(i);
+        character.rarity = rarities[i % 4];
+        character.rate = 0.001 + (i % 7) * 0.001;
+    }
+    return characters;
+}
+
+void setupSystem(GachaSystem& gachaSystem, int64_t characterCount) {
+    gachaSystem.addCharacters(makeCatalog(characterCount));
+    gachaSystem.seed(12345);
+}
+
+// Mengisi riwayat sampai historySize pull, per potongan agar buffer sementara tetap kecil
+void fillHistory(GachaSystem& gachaSystem, int64_t historySize) {
+    const size_t chunk = 1 << 20;
+    std::vector<GachaResult> buffer(chunk);
+    for (int64_t done = 0; done < historySize; done += chunk) {
+        size_t count = static_cast<size_t>(std::min<int64_t>(chunk, historySize - done));
+        gachaSystem.pullBatch(buffer.data(), count);
+    }
+}
+
+// Satu pull per iterasi (termasuk pencatatan riwayat)
+void BM_Pull(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gachaSystem.pull());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Pull)->ArgName("catalog")->Arg(15)->Arg(1000)->Arg(100000);
+
+// Biaya metrik di jalur pull: 0 = dimatikan saat runtime, 1 = aktif
+void BM_PullMetrics(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, 15);
+    GachaMetrics::setEnabled(state.range(0) != 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gachaSystem.pull());
+    }
+    GachaMetrics::setEnabled(true);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PullMetrics)->ArgName("metrics")->Arg(0)->Arg(1);
+
+// 1024 pemain masing-masing meminta 10-pull lewat AsyncGachaServer, semua permintaan dikirim dulu
+// lalu ditunggu bersama; threads = 0 berarti executor hanya dijalankan poll() di thread benchmark
+void BM_AsyncServerPull(benchmark::State& state) {
+    const uint64_t players = 1024;
+    std::shared_ptr<GachaCatalog> catalog = std::make_shared<GachaCatalog>();
+    catalog->addCharacters(makeCatalog(15));
+    catalog->compile();
+    GachaServer server(catalog, 42);
+    server.addPlayers(players);
+    GachaExecutor executor(static_cast<size_t>(state.range(0)));
+    AsyncGachaServer asyncServer(server, executor);
+    
+    std::atomic<uint64_t> pending{ 0 };
+    for (auto _ : state) {
+        pending.store(players);
+        for (uint64_t player = 0; player < players; player++) {
+            executor.spawn(asyncServer.multiPull(player, 0, 10), [&pending](std::vector<GachaResult> results) {
+                benchmark::DoNotOptimize(results.data());
+                pending.fetch_sub(1);
+            });
+        }
+        while (pending.load() != 0) {
+            if (executor.poll() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * players * 10));
+}
+BENCHMARK(BM_AsyncServerPull)->ArgName("threads")->Arg(0)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// Seperti BM_AsyncServerPull tetapi lewat PullScheduler: 10-pull 1024 pemain digabung menjadi batch
+// berisi maksimal maxBatch pull (maxWait 200 us), executor dijalankan poll() di thread benchmark
+void BM_PullScheduler(benchmark::State& state) {
+    const uint64_t players = 1024;
+    std::shared_ptr<GachaCatalog> catalog = std::make_shared<GachaCatalog>();
+    catalog->addCharacters(makeCatalog(15));
+    catalog->compile();
+    GachaServer server(catalog, 42);
+    server.addPlayers(players);
+    GachaExecutor executor(0);
+    PullScheduler scheduler(server, executor, static_cast<size_t>(state.range(0)));
+    
+    std::atomic<uint64_t> pending{ 0 };
+    uint64_t batchesBefore = scheduler.batchesRun();
+    for (auto _ : state) {
+        pending.store(players);
+        for (uint64_t player = 0; player < players; player++) {
+            executor.spawn(scheduler.multiPull(player, 0, 10), [&pending](std::vector<GachaResult> results) {
+                benchmark::DoNotOptimize(results.data());
+                pending.fetch_sub(1);
+            });
+        }
+        while (pending.load() != 0) {
+            if (executor.poll() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * players * 10));
+    state.counters["batches"] = benchmark::Counter(static_cast<double>(scheduler.batchesRun() - batchesBefore),
+                                                   benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_PullScheduler)->ArgName("maxBatch")->Arg(10)->Arg(256)->Arg(4096)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// Jumlah alokasi per pull dalam keadaan stabil: batch = 1 lewat pull(), selain itu pullBatch(batch).
+// history = 0 riwayat tanpa batas (chunk baru tiap PullHistory::CHUNK_SIZE pull),
+// 1 = ring buffer yang sudah penuh; ring buffer wajib nol alokasi, selain itu benchmark gagal
+// (pemeriksaan yang sama dijalankan ctest lewat tests/pull_alloc_test.cpp)
+void BM_PullAllocations(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, 15);
+    size_t batch = static_cast<size_t>(state.range(0));
+    bool ringBuffer = state.range(1) != 0;
+    if (ringBuffer) {
+        gachaSystem.setHistoryLimit(1 << 16);
+        fillHistory(gachaSystem, 1 << 17);
+    } else {
+        gachaSystem.reserveHistory(1 << 16);
+    }
+    std::vector<GachaResult> buffer(batch);
+    gachaSystem.pullBatch(buffer.data(), batch);
+    
+    uint64_t before = allocationCount();
+    for (auto _ : state) {
+        if (batch == 1) {
+            benchmark::DoNotOptimize(gachaSystem.pull());
+        } else {
+            gachaSystem.pullBatch(buffer.data(), batch);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    uint64_t allocations = allocationCount() - before;
+    
+    uint64_t pulls = state.iterations() * batch;
+    state.SetItemsProcessed(static_cast<int64_t>(pulls));
+    state.counters["allocs_per_pull"] = static_cast<double>(allocations) / static_cast<double>(pulls);
+    if (ringBuffer && allocations != 0) {
+        state.SkipWithError("pull mengalokasi memori dalam keadaan stabil");
+    }
+}
+BENCHMARK(BM_PullAllocations)->ArgNames({ "batch", "history" })->ArgsProduct({ { 1, 256 }, { 0, 1 } });
+
+// multiPull(N) per iterasi, termasuk alokasi vector hasil
+void BM_MultiPull(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, state.range(0));
+    int pulls = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gachaSystem.multiPull(pulls));
+    }
+    state.SetItemsProcessed(state.iterations() * pulls);
+}
+BENCHMARK(BM_MultiPull)->ArgNames({ "catalog", "pulls" })->ArgsProduct({ { 15, 1000, 100000 }, { 10, 1000 } });
+
+// Ringkasan riwayat per rarity untuk ukuran riwayat sampai 100 juta pull
+void BM_CountCharactersByRarity(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, state.range(0));
+    fillHistory(gachaSystem, state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gachaSystem.countCharactersByRarity());
+    }
+    state.counters["history_bytes"] = static_cast<double>(gachaSystem.getHistory().memoryUsage());
+}
+BENCHMARK(BM_CountCharactersByRarity)
+    ->ArgNames({ "catalog", "history" })
+    ->Args({ 15, 1000 })
+    ->Args({ 15, 1000000 })
+    ->Args({ 15, 100000000 })
+    ->Args({ 100000, 1000000 })
+    ->Args({ 100000, 100000000 })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_GetCharactersByRarity(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gachaSystem.getCharactersByRarity(RARITY_SSR));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetCharactersByRarity)->ArgName("catalog")->Arg(15)->Arg(1000)->Arg(100000);
+
+// Satu addCharacter() per iterasi ke katalog berukuran N.
+// Katalog dibuat ulang setiap max(1024, N) penambahan agar ukurannya tetap di antara N dan 2N,
+// sehingga biaya realokasi vector teramortisasi seperti pada pemakaian biasa
+void BM_AddCharacter(benchmark::State& state) {
+    const int64_t ADD_BATCH = std::max<int64_t>(1024, state.range(0));
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, state.range(0));
+    int64_t next = 0;
+    for (auto _ : state) {
+        if (next == ADD_BATCH) {
+            state.PauseTiming();
+            gachaSystem = GachaSystem();
+            setupSystem(gachaSystem, state.range(0));
+            next = 0;
+            state.ResumeTiming();
+        }
+        gachaSystem.addCharacter("New" + std::to_string(next), (next % 2) ? RARITY_SR : RARITY_R, 0.001);
+        next++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddCharacter)->ArgName("catalog")->Arg(15)->Arg(1000)->Arg(100000);
+
+// Satu batch perubahan live (EDIT_BATCH ubah rate + tambah lalu hapus satu karakter) dan compile sekali.
+// Biaya compile sebanding dengan ukuran rarity yang berubah, bukan dengan jumlah perubahan
+void BM_EditAndCompile(benchmark::State& state) {
+    const int64_t EDIT_BATCH = 64;
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, state.range(0));
+    uint32_t characterCount = static_cast<uint32_t>(state.range(0));
+    uint32_t next = 0;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < EDIT_BATCH; i++) {
+            next = (next + 7919) % characterCount;
+            gachaSystem.setCharacterRate(next, 0.001 + (i % 5) * 0.001);
+        }
+        uint32_t added = gachaSystem.addCharacter("Edit" + std::to_string(next), RARITY_SR, 0.002);
+        gachaSystem.removeCharacter(added);
+        benchmark::DoNotOptimize(&gachaSystem.getCatalog());
+    }
+    state.SetItemsProcessed(state.iterations() * (EDIT_BATCH + 2));
+}
+BENCHMARK(BM_EditAndCompile)->ArgName("catalog")->Arg(15)->Arg(1000)->Arg(100000);
+
+// Parsing file definisi banner berisi N karakter sampai katalog siap dipakai
+void BM_ParseBannerConfig(benchmark::State& state) {
+    std::string text = "[bench]\npity = 90 | 75 | 5.0\nrates = 0.01 | 0.05 | 0.15 | 0.79\n";
+    for (const Character& character : makeCatalog(state.range(0))) {
+        text += std::string(rarityName(character.rarity)) + " | " + character.name + " | " +
+                std::to_string(character.rate) + " | Title | Element\n";
+    }
+    for (auto _ : state) {
+        std::vector<BannerDefinition> banners;
+        std::string error;
+        if (!parseBannerConfig(text, banners, error)) {
+            state.SkipWithError(error.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(banners.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseBannerConfig)->ArgName("catalog")->Arg(15)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Pull 10x di server dengan N banner aktif (bergantian, setiap dua banner berbagi jalur pity).
+// Waktu per pull harus tetap sama berapa pun jumlah banner-nya
+void BM_ServerPullBanners(benchmark::State& state) {
+    const int64_t PLAYERS = 1024;
+    std::shared_ptr<GachaCatalog> catalog = std::make_shared<GachaCatalog>();
+    catalog->addCharacters(makeCatalog(1000));
+    catalog->compile();
+    std::shared_ptr<BannerRegistry> registry = std::make_shared<BannerRegistry>();
+    for (int64_t i = 0; i < state.range(0); i++) {
+        registry->addBanner("banner" + std::to_string(i), catalog, "track" + std::to_string(i / 2));
+    }
+    
+    GachaServer server(registry, 12345);
+    server.addPlayers(PLAYERS);
+    GachaResult results[10];
+    uint64_t next = 0;
+    for (auto _ : state) {
+        uint32_t bannerId = static_cast<uint32_t>(next % static_cast<uint64_t>(state.range(0)));
+        server.pull(next % PLAYERS, bannerId, results, 10);
+        benchmark::DoNotOptimize(results);
+        next++;
+    }
+    state.SetItemsProcessed(state.iterations() * 10);
+}
+BENCHMARK(BM_ServerPullBanners)->ArgName("banners")->Arg(1)->Arg(3)->Arg(200);
+
+// resolveBatch 1000 pull: 0 = banner biasa, 1 = 50/50 klasik, 2 = 50/50 + capture + fate point
+void BM_PullFeatured(benchmark::State& state) {
+    GachaCatalog catalog;
+    catalog.addCharacters(makeCatalog(1000));
+    FeaturedRules rules;
+    if (state.range(0) == 2) {
+        rules.captureStreak = 2;
+        rules.captureChance = 0.75;
+        rules.fatePoints = 1;
+    }
+    if (state.range(0) > 0) {
+        catalog.setFeatured({ 0, 4 }, rules);
+    }
+    catalog.compile();
+    
+    const size_t PULLS = 1000;
+    GachaRng rng;
+    rng.seed(RNG_PHILOX4X32, 12345, 0);
+    std::vector<double> uniforms(2 * PULLS);
+    rng.fill(uniforms.data(), uniforms.size());
+    std::vector<GachaResult> results(PULLS);
+    PityState pity;
+    pity.pullCount = 0;
+    pity.selectedCharPity = 0;
+    pity.featuredState = 0;
+    for (auto _ : state) {
+        catalog.resolveBatch(pity, uniforms.data(), PULLS, results.data());
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * PULLS);
+}
+BENCHMARK(BM_PullFeatured)->ArgName("rules")->Arg(0)->Arg(1)->Arg(2);
+
+// resolveBatch 1000 pull dengan kurva soft pity: 0 = faktor tetap, 1 = linear, 2 = tabel
+void BM_PullSoftPityCurve(benchmark::State& state) {
+    GachaCatalog catalog;
+    catalog.addCharacters(makeCatalog(1000));
+    SoftPityCurve curves[] = {
+        SoftPityCurve::multiply(5.0),
+        SoftPityCurve::linear(0.06),
+        SoftPityCurve::table({ 0.02, 0.04, 0.08, 0.15, 0.3, 0.5 }),
+    };
+    catalog.setPitySettings(90, 74, curves[state.range(0)]);
+    catalog.compile();
+    
+    const size_t PULLS = 1000;
+    GachaRng rng;
+    rng.seed(RNG_PHILOX4X32, 12345, 0);
+    std::vector<double> uniforms(2 * PULLS);
+    rng.fill(uniforms.data(), uniforms.size());
+    std::vector<GachaResult> results(PULLS);
+    PityState pity;
+    pity.pullCount = 0;
+    pity.selectedCharPity = 0;
+    pity.featuredState = 0;
+    for (auto _ : state) {
+        catalog.resolveBatch(pity, uniforms.data(), PULLS, results.data());
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * PULLS);
+}
+BENCHMARK(BM_PullSoftPityCurve)->ArgName("curve")->Arg(0)->Arg(1)->Arg(2);
+
+// Stream yang membuang semua keluaran, agar yang diukur hanya format dan penulisan
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+    
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+// Menampilkan 10k hasil pull: 0 = ResultRenderer di thread pemanggil, 1 = AsyncResultWriter per 1000 hasil
+void BM_RenderResults(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, 1000);
+    const size_t PULLS = 10000;
+    const size_t CHUNK = 1000;
+    std::vector<GachaResult> results(PULLS);
+    gachaSystem.pullBatch(results.data(), PULLS);
+    
+    NullBuffer nullBuffer;
+    std::ostream out(&nullBuffer);
+    if (state.range(0) == 0) {
+        ResultRenderer renderer(gachaSystem.getCatalog());
+        for (auto _ : state) {
+            renderer.append(results.data(), PULLS, "Pull #", 1);
+            renderer.writeTo(out);
+        }
+    } else {
+        AsyncResultWriter writer(gachaSystem.getCatalog(), out, "Pull #");
+        for (auto _ : state) {
+            for (size_t done = 0; done < PULLS; done += CHUNK) {
+                writer.submit(results.data() + done, CHUNK, done + 1);
+            }
+            writer.flush();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PULLS);
+}
+BENCHMARK(BM_RenderResults)->ArgName("async")->Arg(0)->Arg(1);
+
+// Analitik satu pass atas 4M record catatan pull di memori: 0 = semua core, selain itu jumlah thread
+void BM_AnalyzePullLog(benchmark::State& state) {
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, 1000);
+    const size_t RECORDS = 1 << 22;
+    std::vector<GachaResult> results(RECORDS);
+    gachaSystem.pullBatch(results.data(), RECORDS);
+    std::vector<PullLogRecord> records(RECORDS);
+    for (size_t i = 0; i < RECORDS; i++) {
+        records[i] = makePullLogRecord(i % 1000, i / 1000, results[i]);
+    }
+    
+    PullLogAnalyzer analyzer(gachaSystem.getCatalog());
+    for (auto _ : state) {
+        PullLogStats stats = analyzer.analyze(records.data(), records.size(), static_cast<unsigned>(state.range(0)));
+        benchmark::DoNotOptimize(stats.records);
+    }
+    state.SetItemsProcessed(state.iterations() * RECORDS);
+}
+BENCHMARK(BM_AnalyzePullLog)->ArgName("threads")->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+// Verifikasi ulang 4M record (1024 pemain x 4096 pull): setiap record diulang dengan Philox yang
+// langsung melompat ke pullIndex-nya. 0 = semua core, selain itu jumlah thread
+void BM_VerifyPullLog(benchmark::State& state) {
+    const uint64_t SEED = 12345;
+    const size_t PLAYERS = 1024;
+    const size_t PULLS = 4096;
+    GachaSystem gachaSystem;
+    setupSystem(gachaSystem, 1000);
+    gachaSystem.setHistoryLimit(PULLS);
+    const GachaCatalog& catalog = gachaSystem.getCatalog();
+    uint16_t version = catalog.fingerprint();
+    
+    std::vector<GachaResult> results(PULLS);
+    std::vector<PullLogRecord> records;
+    records.reserve(PLAYERS * PULLS);
+    for (size_t player = 0; player < PLAYERS; player++) {
+        gachaSystem.setRng(RNG_PHILOX4X32, SEED, player);
+        gachaSystem.pullBatch(results.data(), PULLS);
+        for (size_t i = 0; i < PULLS; i++) {
+            PullLogRecord record = makePullLogRecord(player, i, results[i]);
+            record.selectedCharPity = static_cast<uint32_t>(gachaSystem.getSelectedCharPity());
+            record.bannerVersion = version;
+            records.push_back(record);
+        }
+    }
+    
+    PullLogVerifier verifier;
+    verifier.addCatalog(0, std::make_shared<GachaCatalog>(catalog));
+    for (auto _ : state) {
+        AuditReport report = verifier.verify(records.data(), records.size(), SEED, static_cast<unsigned>(state.range(0)));
+        if (!report.clean()) {
+            state.SkipWithError("catatan pull tidak cocok dengan hasil yang diulang");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * records.size());
+}
+BENCHMARK(BM_VerifyPullLog)->ArgName("threads")->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+#ifndef GACHA_ALIAS_TABLE_H
+#define GACHA_ALIAS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Tabel alias (metode Walker/Vose) untuk memilih indeks berbobot dalam O(1)
+class AliasTable {
+private:
+    std::vector<double> prob;     // Peluang tetap di kolom sendiri
+    std::vector<uint32_t> alias;  // Kolom pengganti jika tidak lolos prob
+
+public:
+    // Membangun tabel dari daftar bobot (tidak harus ternormalisasi)
+    void build(const std::vector<double>& weights) {
+        size_t n = weights.size();
+        prob.assign(n, 1.0);
+        alias.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            alias[i] = static_cast<uint32_t>(i);
+        }
+        
+        double total = 0.0;
+        for (double weight : weights) {
+            total += weight;
+        }
+        
+        // Sama seperti scan kumulatif: jika semua bobot nol, karakter pertama yang terpilih
+        if (n == 0 || total <= 0.0) {
+            for (size_t i = 1; i < n; i++) {
+                prob[i] = 0.0;
+                alias[i] = 0;
+            }
+            return;
+        }
+        
+        std::vector<double> scaled(n);
+        std::vector<uint32_t> small;
+        std::vector<uint32_t> large;
+        for (size_t i = 0; i < n; i++) {
+            scaled[i] = weights[i] * n / total;
+            if (scaled[i] < 1.0) {
+                small.push_back(static_cast<uint32_t>(i));
+            } else {
+                large.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        
+        while (!small.empty() && !large.empty()) {
+            uint32_t less = small.back();
+            small.pop_back();
+            uint32_t more = large.back();
+            large.pop_back();
+            
+            prob[less] = scaled[less];
+            alias[less] = more;
+            scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+            
+            if (scaled[more] < 1.0) {
+                small.push_back(more);
+            } else {
+                large.push_back(more);
+            }
+        }
+        
+        // Sisa kolom (termasuk galat pembulatan) selalu memilih dirinya sendiri
+        for (uint32_t i : small) {
+            prob[i] = 1.0;
+        }
+        for (uint32_t i : large) {
+            prob[i] = 1.0;
+        }
+    }
+    
+    bool empty() const {
+        return prob.empty();
+    }
+    
+    // Memilih indeks dengan satu angka random u di [0, 1)
+    uint32_t sample(double u) const {
+        double scaledU = u * prob.size();
+        uint32_t column = static_cast<uint32_t>(scaledU);
+        if (column >= prob.size()) {
+            column = static_cast<uint32_t>(prob.size() - 1);
+        }
+        return (scaledU - column) < prob[column] ? column : alias[column];
+    }
+};
+
+#endif // GACHA_ALIAS_TABLE_H
@@ -0,0 +1,424 @@
+#include "banner_config.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#include "snapshot.h"
+
+namespace {
+
+// Banner yang sedang diparsing; karakter langsung masuk katalog, yang dihapus ditandai di akhir
+struct PendingBanner {
+    BannerDefinition banner;
+    std::vector<uint32_t> removed;
+    size_t activeCount[RARITY_COUNT] = {};
+    size_t line = 0;
+    
+    // Rate-up: nama karakter featured dicari setelah semua karakter banner terbaca
+    std::vector<std::string> featuredNames;
+    size_t featuredLine = 0;
+    FeaturedRules featuredRules;
+    
+    // Kurva soft pity dipasang setelah pity (baris "pity" memakai faktor tetap); 0 = tidak ada
+    SoftPityCurve softPityCurve;
+    size_t softPityLine = 0;
+};
+
+std::string_view trim(std::string_view text) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && (text[begin] == ' ' || text[begin] == '\t' || text[begin] == '\r')) {
+        begin++;
+    }
+    while (end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\r')) {
+        end--;
+    }
+    return text.substr(begin, end - begin);
+}
+
+// Memecah baris menjadi field yang dipisah '|', false jika lebih dari maxFields
+bool splitFields(std::string_view line, std::string_view* fields, size_t maxFields, size_t& count) {
+    count = 0;
+    while (true) {
+        size_t separator = line.find('|');
+        if (count == maxFields) {
+            return false;
+        }
+        fields[count++] = trim(line.substr(0, separator));
+        if (separator == std::string_view::npos) {
+            return true;
+        }
+        line.remove_prefix(separator + 1);
+    }
+}
+
+// Memecah seluruh field yang dipisah '|' tanpa batas jumlah
+std::vector<std::string_view> splitAll(std::string_view line) {
+    std::vector<std::string_view> fields;
+    while (true) {
+        size_t separator = line.find('|');
+        fields.push_back(trim(line.substr(0, separator)));
+        if (separator == std::string_view::npos) {
+            return fields;
+        }
+        line.remove_prefix(separator + 1);
+    }
+}
+
+bool parseInt(std::string_view text, int& value) {
+    const char* end = text.data() + text.size();
+    std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+bool parseDouble(std::string_view text, double& value) {
+    const char* end = text.data() + text.size();
+    std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end && std::isfinite(value);
+}
+
+bool parseRarityName(std::string_view text, Rarity& rarity) {
+    for (int i = 0; i < RARITY_COUNT; i++) {
+        if (text == rarityName(static_cast<Rarity>(i))) {
+            rarity = static_cast<Rarity>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Jumlah baris sampai header [banner] berikutnya (batas atas jumlah karakter banner yang sedang dibaca)
+size_t linesUntilNextBanner(std::string_view text) {
+    size_t lines = 0;
+    while (!text.empty()) {
+        size_t newline = text.find('\n');
+        std::string_view line = trim(text.substr(0, newline));
+        if (!line.empty() && line.front() == '[') {
+            break;
+        }
+        lines++;
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    }
+    return lines;
+}
+
+std::string lineError(size_t line, const std::string& message) {
+    return "baris " + std::to_string(line) + ": " + message;
+}
+
+// Baris "kunci = a | b | ..." di dalam banner
+bool parseSetting(PendingBanner& pending, std::string_view key, std::string_view value, size_t line, std::string& error) {
+    // Jumlah karakter featured dan panjang tabel soft pity tidak dibatasi, jadi dipecah tersendiri
+    if (key == "featured") {
+        pending.featuredNames.clear();
+        for (std::string_view name : splitAll(value)) {
+            if (name.empty()) {
+                error = lineError(line, "format featured: nama | nama | ...");
+                return false;
+            }
+            pending.featuredNames.emplace_back(name);
+        }
+        pending.featuredLine = line;
+        return true;
+    }
+    
+    if (key == "soft_pity") {
+        std::vector<std::string_view> parts = splitAll(value);
+        std::vector<double> numbers(parts.size() - 1);
+        for (size_t i = 1; i < parts.size(); i++) {
+            if (!parseDouble(parts[i], numbers[i - 1])) {
+                error = lineError(line, "nilai soft pity bukan angka: " + std::string(parts[i]));
+                return false;
+            }
+        }
+        SoftPityCurve curve;
+        if (parts[0] == "multiply" && numbers.size() == 1) {
+            curve = SoftPityCurve::multiply(numbers[0]);
+        } else if (parts[0] == "linear" && numbers.size() == 1) {
+            curve = SoftPityCurve::linear(numbers[0]);
+        } else if (parts[0] == "table" && !numbers.empty()) {
+            curve = SoftPityCurve::table(std::move(numbers));
+        } else {
+            error = lineError(line, "format soft_pity: multiply | faktor, linear | kenaikan, atau table | p | p | ...");
+            return false;
+        }
+        if (!curve.valid()) {
+            error = lineError(line, "kurva soft pity tidak valid (faktor > 1, kenaikan 0..1, peluang tabel 0..1)");
+            return false;
+        }
+        pending.softPityCurve = std::move(curve);
+        pending.softPityLine = line;
+        return true;
+    }
+    
+    std::string_view fields[RARITY_COUNT + 1];
+    size_t count = 0;
+    bool fits = splitFields(value, fields, RARITY_COUNT + 1, count);
+    
+    if (key == "track") {
+        if (!fits || count != 1 || fields[0].empty()) {
+            error = lineError(line, "format track: nama_jalur");
+            return false;
+        }
+        pending.banner.pityTrack.assign(fields[0].data(), fields[0].size());
+        return true;
+    }
+    
+    if (key == "pity") {
+        int hardPity = 0;
+        int softPityStart = 0;
+        double softPityBoost = 0.0;
+        if (!fits || count != 3 || !parseInt(fields[0], hardPity) || !parseInt(fields[1], softPityStart) ||
+            !parseDouble(fields[2], softPityBoost)) {
+            error = lineError(line, "format pity: hard | soft | boost");
+            return false;
+        }
+        if (!pending.banner.catalog.setPitySettings(hardPity, softPityStart, softPityBoost)) {
+            error = lineError(line, "pity tidak valid (0 < soft < hard <= " + std::to_string(MAX_HARD_PITY) + ", boost > 1)");
+            return false;
+        }
+        return true;
+    }
+    
+    if (key == "rates") {
+        double rates[RARITY_COUNT];
+        if (!fits || count != RARITY_COUNT) {
+            error = lineError(line, "format rates: SSR | SR | R | Common");
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!parseDouble(fields[i], rates[i])) {
+                error = lineError(line, "rate bukan angka: " + std::string(fields[i]));
+                return false;
+            }
+        }
+        if (!pending.banner.catalog.setRarityRates(rates)) {
+            error = lineError(line, "rate rarity harus di antara 0 dan 1 dan berjumlah 1");
+            return false;
+        }
+        return true;
+    }
+    
+    if (key == "featured_chance") {
+        double chance = 0.0;
+        if (!fits || count != 1 || !parseDouble(fields[0], chance) || chance < 0.0 || chance > 1.0) {
+            error = lineError(line, "format featured_chance: peluang 0..1");
+            return false;
+        }
+        pending.featuredRules.featuredChance = chance;
+        return true;
+    }
+    
+    if (key == "guarantee") {
+        int guarantee = 0;
+        if (!fits || count != 1 || !parseInt(fields[0], guarantee) || (guarantee != 0 && guarantee != 1)) {
+            error = lineError(line, "format guarantee: 1 (kalah 50/50 = SSR berikutnya featured) atau 0");
+            return false;
+        }
+        pending.featuredRules.guaranteeAfterLoss = guarantee == 1;
+        return true;
+    }
+    
+    if (key == "capture") {
+        int streak = 0;
+        double chance = 0.0;
+        if (!fits || count != 2 || !parseInt(fields[0], streak) || !parseDouble(fields[1], chance) ||
+            streak < 0 || streak > MAX_FEATURED_STREAK || chance < 0.0 || chance > 1.0) {
+            error = lineError(line, "format capture: kalah beruntun (0.." + std::to_string(MAX_FEATURED_STREAK) +
+                              ") | peluang 0..1");
+            return false;
+        }
+        pending.featuredRules.captureStreak = streak;
+        pending.featuredRules.captureChance = chance;
+        return true;
+    }
+    
+    if (key == "fate") {
+        int fatePoints = 0;
+        if (!fits || count != 1 || !parseInt(fields[0], fatePoints) || fatePoints < 0 ||
+            fatePoints > MAX_FEATURED_STREAK) {
+            error = lineError(line, "format fate: jumlah fate point 0.." + std::to_string(MAX_FEATURED_STREAK));
+            return false;
+        }
+        pending.featuredRules.fatePoints = fatePoints;
+        return true;
+    }
+    
+    error = lineError(line, "pengaturan tidak dikenal: " + std::string(key));
+    return false;
+}
+
+// Baris "RARITY | nama | rate | title | element [| removed]"
+bool parseCharacter(PendingBanner& pending, std::string_view text, size_t line, std::string& error) {
+    std::string_view fields[6];
+    size_t count = 0;
+    if (!splitFields(text, fields, 6, count) || count < 5) {
+        error = lineError(line, "format karakter: rarity | nama | rate | title | element [| removed]");
+        return false;
+    }
+    
+    Character character;
+    if (!parseRarityName(fields[0], character.rarity)) {
+        error = lineError(line, "rarity tidak dikenal: " + std::string(fields[0]));
+        return false;
+    }
+    if (fields[1].empty()) {
+        error = lineError(line, "nama karakter kosong");
+        return false;
+    }
+    if (!parseDouble(fields[2], character.rate) || character.rate < 0.0) {
+        error = lineError(line, "rate karakter tidak valid: " + std::string(fields[2]));
+        return false;
+    }
+    if (count == 6) {
+        if (fields[5] != "removed") {
+            error = lineError(line, "field keenam hanya boleh \"removed\"");
+            return false;
+        }
+        pending.removed.push_back(static_cast<uint32_t>(pending.banner.catalog.size()));
+    } else {
+        pending.activeCount[character.rarity]++;
+    }
+    character.name.assign(fields[1].data(), fields[1].size());
+    character.title.assign(fields[3].data(), fields[3].size());
+    character.element.assign(fields[4].data(), fields[4].size());
+    pending.banner.catalog.addCharacter(std::move(character));
+    return true;
+}
+
+// Menandai karakter yang dihapus, memasang rate-up, memeriksa bobotnya, lalu mengompilasi
+bool finishBanner(PendingBanner& pending, std::vector<BannerDefinition>& parsed, std::string& error) {
+    GachaCatalog& catalog = pending.banner.catalog;
+    for (uint32_t characterId : pending.removed) {
+        catalog.removeCharacter(characterId);
+    }
+    
+    std::vector<uint32_t> featured;
+    for (const std::string& name : pending.featuredNames) {
+        int characterId = catalog.findSSRCharacter(name);
+        if (characterId < 0) {
+            error = lineError(pending.featuredLine, "karakter featured bukan SSR aktif di banner ini: " + name);
+            return false;
+        }
+        featured.push_back(static_cast<uint32_t>(characterId));
+    }
+    if (!catalog.setFeatured(featured, pending.featuredRules)) {
+        // Aturan rate-up tanpa baris featured dilaporkan di baris judul banner
+        size_t line = pending.featuredLine != 0 ? pending.featuredLine : pending.line;
+        error = lineError(line, "rate-up banner " + pending.banner.name +
+                          " ditolak (karakter bukan SSR atau aturan di luar batas)");
+        return false;
+    }
+    
+    if (pending.softPityLine != 0 &&
+        !catalog.setPitySettings(catalog.getHardPity(), catalog.getSoftPityStart(), pending.softPityCurve)) {
+        error = lineError(pending.softPityLine, "kurva soft pity tidak cocok dengan pengaturan pity");
+        return false;
+    }
+    
+    // Rarity yang punya karakter aktif harus punya total bobot positif agar undiannya bermakna
+    for (int i = 0; i < RARITY_COUNT; i++) {
+        Rarity rarity = static_cast<Rarity>(i);
+        if (pending.activeCount[i] > 0 && !(catalog.getCharacterRateTotal(rarity) > 0.0)) {
+            error = lineError(pending.line, "banner " + pending.banner.name + ": total rate karakter " +
+                              rarityName(rarity) + " harus lebih dari 0");
+            return false;
+        }
+    }
+    
+    catalog.compile();
+    parsed.push_back(std::move(pending.banner));
+    return true;
+}
+
+}  // namespace
+
+bool parseBannerConfig(std::string_view text, std::vector<BannerDefinition>& banners, std::string& error) {
+    std::vector<BannerDefinition> parsed;
+    PendingBanner pending;
+    bool inBanner = false;
+    size_t lineNumber = 0;
+    
+    while (!text.empty()) {
+        size_t newline = text.find('\n');
+        std::string_view line = trim(text.substr(0, newline));
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+        lineNumber++;
+        
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        
+        if (line.front() == '[') {
+            if (line.back() != ']' || trim(line.substr(1, line.size() - 2)).empty()) {
+                error = lineError(lineNumber, "nama banner tidak valid");
+                return false;
+            }
+            if (inBanner && !finishBanner(pending, parsed, error)) {
+                return false;
+            }
+            
+            std::string_view name = trim(line.substr(1, line.size() - 2));
+            if (findBanner(parsed, name) || findBanner(banners, name)) {
+                error = lineError(lineNumber, "banner duplikat: " + std::string(name));
+                return false;
+            }
+            pending = PendingBanner();
+            pending.banner.name.assign(name.data(), name.size());
+            pending.banner.pityTrack = pending.banner.name;
+            pending.banner.catalog.reserve(linesUntilNextBanner(text));
+            pending.line = lineNumber;
+            inBanner = true;
+            continue;
+        }
+        
+        if (!inBanner) {
+            error = lineError(lineNumber, "baris di luar [banner]");
+            return false;
+        }
+        
+        // Pengaturan memakai '=' sebelum '|' pertama, selain itu baris karakter
+        size_t equals = line.find('=');
+        if (equals != std::string_view::npos && equals < line.find('|')) {
+            if (!parseSetting(pending, trim(line.substr(0, equals)), line.substr(equals + 1), lineNumber, error)) {
+                return false;
+            }
+        } else if (!parseCharacter(pending, line, lineNumber, error)) {
+            return false;
+        }
+    }
+    
+    if (inBanner && !finishBanner(pending, parsed, error)) {
+        return false;
+    }
+    if (parsed.empty()) {
+        error = "tidak ada [banner] di konfigurasi";
+        return false;
+    }
+    
+    for (BannerDefinition& banner : parsed) {
+        banners.push_back(std::move(banner));
+    }
+    return true;
+}
+
+bool loadBannerFile(const std::string& path, std::vector<BannerDefinition>& banners, std::string& error) {
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "tidak bisa membuka " + path;
+        return false;
+    }
+    return parseBannerConfig(std::string_view(file.bytes(), file.length()), banners, error);
+}
+
+const BannerDefinition* findBanner(const std::vector<BannerDefinition>& banners, std::string_view name) {
+    for (const BannerDefinition& banner : banners) {
+        if (banner.name == name) {
+            return &banner;
+        }
+    }
+    return nullptr;
+}
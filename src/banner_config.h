@@ -0,0 +1,48 @@
+#ifndef GACHA_BANNER_CONFIG_H
+#define GACHA_BANNER_CONFIG_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gacha_catalog.h"
+
+// Format file definisi banner (teks per baris, '#' = komentar, spasi di tepi field diabaikan):
+//
+//   [nama_banner]
+//   pity = 90 | 75 | 5.0                 (hard pity | awal soft pity | boost soft pity)
+//   rates = 0.01 | 0.05 | 0.15 | 0.79    (SSR | SR | R | Common, jumlahnya harus 1)
+//   soft_pity = linear | 0.06            (kurva soft pity, menggantikan boost di baris pity:
+//                                          multiply | faktor, linear | kenaikan peluang SSR per pull,
+//                                          atau table | p | p | ... = peluang SSR mulai awal soft pity)
+//   track = limited                      (jalur pity; banner dengan jalur sama berbagi counter pity)
+//   featured = nama | nama               (SSR rate-up; tanpa baris ini banner tidak punya 50/50)
+//   featured_chance = 0.5                (peluang SSR jatuh ke karakter featured)
+//   guarantee = 1                        (1 = kalah 50/50 membuat SSR berikutnya pasti featured)
+//   capture = 2 | 0.75                   (setelah kalah beruntun sebanyak ini, peluang featured menjadi 0.75)
+//   fate = 1                             (SSR bukan karakter pilihan sebanyak ini = SSR berikutnya karakter pilihan)
+//   SSR | nama | rate | title | element  (rate = bobot relatif di dalam rarity-nya)
+//   SSR | nama | rate | title | element | removed
+//
+// ID karakter = urutan barisnya di dalam banner, jadi karakter lama tidak boleh dihapus atau
+// dipindah; tandai dengan "removed" agar ID karakter berikutnya dan riwayat pemain tetap cocok.
+// Pengaturan yang tidak ditulis memakai nilai bawaan GachaCatalog, jalur pity bawaan = nama banner
+
+// Satu banner hasil parsing, katalognya sudah dikompilasi
+struct BannerDefinition {
+    std::string name;
+    std::string pityTrack;
+    GachaCatalog catalog;
+};
+
+// Parsing seluruh isi file ke banners (ditambahkan di akhir). False jika ada yang tidak valid,
+// dengan pesan "baris N: ..." di error; banners tidak berubah jika gagal
+bool parseBannerConfig(std::string_view text, std::vector<BannerDefinition>& banners, std::string& error);
+
+// Memetakan file lalu parsing tanpa menyalin isinya
+bool loadBannerFile(const std::string& path, std::vector<BannerDefinition>& banners, std::string& error);
+
+// Mencari banner berdasarkan nama, nullptr jika tidak ada
+const BannerDefinition* findBanner(const std::vector<BannerDefinition>& banners, std::string_view name);
+
+#endif // GACHA_BANNER_CONFIG_H
@@ -0,0 +1,257 @@
+#ifndef GACHA_BANNER_REGISTRY_H
+#define GACHA_BANNER_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "banner_config.h"
+#include "gacha_catalog.h"
+#include "snapshot.h"
+
+// Satu banner di registry: katalog terkompilasi yang tidak diubah lagi dan jalur pity yang dipakainya
+struct BannerEntry {
+    std::string name;
+    std::shared_ptr<const GachaCatalog> catalog;
+    uint32_t pityTrack;
+    uint16_t version;   // GachaCatalog::fingerprint(), dicatat di catatan pull
+};
+
+// Daftar banner yang aktif bersamaan. Banner yang memakai jalur pity yang sama berbagi counter pity
+// pemain (mis. dua banner limited bergantian), banner lain punya counter sendiri.
+// Registry dibangun sekali lalu dibagikan sebagai shared_ptr<const>; perubahan = registry baru
+class BannerRegistry {
+private:
+    std::vector<BannerEntry> banners;
+    std::vector<std::string> trackNames;
+    std::vector<int> trackHardPity;     // Hard pity yang sama untuk semua banner di satu jalur
+
+public:
+    // Menambah banner, mengembalikan ID-nya atau -1 jika nama sudah ada, registry penuh,
+    // atau hard pity-nya berbeda dengan banner lain di jalur yang sama. Jalur baru dibuat otomatis
+    int addBanner(const std::string& name, std::shared_ptr<const GachaCatalog> catalog, const std::string& trackName) {
+        if (findBanner(name) >= 0 || banners.size() >= PlayerColumns::MAX_COLUMNS) {
+            return -1;
+        }
+        
+        // Katalog harus terkompilasi karena registry tidak pernah mengubahnya
+        if (catalog->needsCompile()) {
+            std::shared_ptr<GachaCatalog> copy = std::make_shared<GachaCatalog>(*catalog);
+            copy->compile();
+            catalog = copy;
+        }
+        
+        int track = findTrack(trackName);
+        if (track < 0) {
+            if (trackNames.size() >= PlayerColumns::MAX_COLUMNS) {
+                return -1;
+            }
+            track = static_cast<int>(trackNames.size());
+            trackNames.push_back(trackName);
+            trackHardPity.push_back(catalog->getHardPity());
+        } else if (trackHardPity[track] != catalog->getHardPity()) {
+            return -1;
+        }
+        
+        BannerEntry entry;
+        entry.name = name;
+        entry.version = catalog->fingerprint();
+        entry.catalog = std::move(catalog);
+        entry.pityTrack = static_cast<uint32_t>(track);
+        banners.push_back(std::move(entry));
+        return static_cast<int>(banners.size()) - 1;
+    }
+    
+    // Menambah semua banner hasil parsing file konfigurasi, false dengan pesan di error jika ada yang ditolak
+    bool addBanners(const std::vector<BannerDefinition>& definitions, std::string& error) {
+        for (const BannerDefinition& definition : definitions) {
+            std::shared_ptr<const GachaCatalog> catalog = std::make_shared<GachaCatalog>(definition.catalog);
+            if (addBanner(definition.name, catalog, definition.pityTrack) < 0) {
+                error = "banner " + definition.name + " ditolak (nama ganda, terlalu banyak banner, atau hard pity " +
+                        "berbeda dengan banner lain di jalur " + definition.pityTrack + ")";
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Mengganti katalog satu banner (hard pity harus tetap sama dengan jalurnya jika jalur itu dipakai banner lain)
+    bool replaceCatalog(uint32_t bannerId, std::shared_ptr<const GachaCatalog> catalog) {
+        if (bannerId >= banners.size()) {
+            return false;
+        }
+        if (catalog->needsCompile()) {
+            std::shared_ptr<GachaCatalog> copy = std::make_shared<GachaCatalog>(*catalog);
+            copy->compile();
+            catalog = copy;
+        }
+        
+        uint32_t track = banners[bannerId].pityTrack;
+        for (size_t i = 0; i < banners.size(); i++) {
+            if (i != bannerId && banners[i].pityTrack == track && catalog->getHardPity() != trackHardPity[track]) {
+                return false;
+            }
+        }
+        trackHardPity[track] = catalog->getHardPity();
+        banners[bannerId].version = catalog->fingerprint();
+        banners[bannerId].catalog = std::move(catalog);
+        return true;
+    }
+    
+    // True jika registry ini hanya menambah banner dan jalur di akhir previous (ID lama tetap berlaku)
+    bool extends(const BannerRegistry& previous) const {
+        if (banners.size() < previous.banners.size() || trackNames.size() < previous.trackNames.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < previous.trackNames.size(); i++) {
+            if (trackNames[i] != previous.trackNames[i]) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < previous.banners.size(); i++) {
+            if (banners[i].name != previous.banners[i].name || banners[i].pityTrack != previous.banners[i].pityTrack) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    size_t size() const {
+        return banners.size();
+    }
+    
+    size_t trackCount() const {
+        return trackNames.size();
+    }
+    
+    // Lookup O(1) dengan ID banner (pemanggil memastikan ID < size())
+    const BannerEntry& getBanner(uint32_t bannerId) const {
+        return banners[bannerId];
+    }
+    
+    const std::string& getTrackName(uint32_t track) const {
+        return trackNames[track];
+    }
+    
+    int getTrackHardPity(uint32_t track) const {
+        return trackHardPity[track];
+    }
+    
+    // Mencari ID banner berdasarkan nama, -1 jika tidak ada
+    int findBanner(const std::string& name) const {
+        for (size_t i = 0; i < banners.size(); i++) {
+            if (banners[i].name == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+    
+    int findTrack(const std::string& name) const {
+        for (size_t i = 0; i < trackNames.size(); i++) {
+            if (trackNames[i] == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+    
+    // True jika kolom pemain cocok dengan registry (jumlah kolom, counter di bawah hard pity, karakter pity valid)
+    bool accepts(const PlayerColumns& players) const {
+        if (players.trackCount != trackNames.size() || players.bannerCount != banners.size()) {
+            return false;
+        }
+        for (uint64_t id = 0; id < players.count; id++) {
+            for (size_t track = 0; track < trackNames.size(); track++) {
+                int32_t pullCount = players.pullCounts[id * players.trackCount + track];
+                if (pullCount < 0 || pullCount >= trackHardPity[track]) {
+                    return false;
+                }
+            }
+            for (size_t banner = 0; banner < banners.size(); banner++) {
+                uint32_t selected = players.selectedCharPity[id * players.bannerCount + banner];
+                if (selected != 0 && selected >= banners[banner].catalog->size()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    
+    // Section SECTION_BANNERS diikuti katalog setiap banner (section CATALOG berurutan sesuai ID)
+    void writeTo(SnapshotWriter& writer) const {
+        writer.beginSection(SECTION_BANNERS);
+        writer.put<uint32_t>(static_cast<uint32_t>(trackNames.size()));
+        writer.put<uint32_t>(static_cast<uint32_t>(banners.size()));
+        for (const std::string& trackName : trackNames) {
+            writer.putString(trackName);
+        }
+        for (const BannerEntry& banner : banners) {
+            writer.putString(banner.name);
+            writer.put<uint32_t>(banner.pityTrack);
+        }
+        writer.endSection();
+        
+        for (const BannerEntry& banner : banners) {
+            banner.catalog->writeTo(writer);
+        }
+    }
+    
+    // Memuat registry dari snapshot, false (tanpa perubahan) jika isinya tidak valid
+    bool readFrom(const SnapshotFile& file) {
+        SnapshotReader reader(nullptr, 0, 0);
+        if (!file.findSection(SECTION_BANNERS, reader)) {
+            return false;
+        }
+        uint32_t tracks = reader.get<uint32_t>();
+        uint32_t count = reader.get<uint32_t>();
+        if (!reader.ok() || tracks == 0 || tracks > PlayerColumns::MAX_COLUMNS || count == 0 ||
+            count > PlayerColumns::MAX_COLUMNS) {
+            return false;
+        }
+        std::vector<std::string> names(tracks);
+        for (std::string& name : names) {
+            name = reader.getString();
+        }
+        
+        BannerRegistry loaded;
+        for (uint32_t i = 0; i < count; i++) {
+            std::string name = reader.getString();
+            uint32_t track = reader.get<uint32_t>();
+            SnapshotReader catalogReader(nullptr, 0, 0);
+            std::shared_ptr<GachaCatalog> catalog = std::make_shared<GachaCatalog>();
+            if (!reader.ok() || track >= tracks || !file.findSection(SECTION_CATALOG, catalogReader, i) ||
+                !catalog->readFrom(catalogReader)) {
+                return false;
+            }
+            
+            // Jalur dibuat sesuai urutan file agar ID jalur tetap sama
+            while (loaded.trackNames.size() <= track) {
+                loaded.trackNames.push_back(names[loaded.trackNames.size()]);
+                loaded.trackHardPity.push_back(0);
+            }
+            if (loaded.trackHardPity[track] == 0) {
+                loaded.trackHardPity[track] = catalog->getHardPity();
+            }
+            if (loaded.trackHardPity[track] != catalog->getHardPity() || loaded.findBanner(name) >= 0) {
+                return false;
+            }
+            BannerEntry entry;
+            entry.name = name;
+            entry.catalog = catalog;
+            entry.pityTrack = track;
+            entry.version = catalog->fingerprint();
+            loaded.banners.push_back(std::move(entry));
+        }
+        if (loaded.trackNames.size() != tracks) {
+            return false;
+        }
+        *this = std::move(loaded);
+        return true;
+    }
+};
+
+#endif // GACHA_BANNER_REGISTRY_H
@@ -0,0 +1,674 @@
+#include "batch_runner.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include "banner_config.h"
+#include "gacha_catalog.h"
+#include "gacha_simulator.h"
+#include "gacha_types.h"
+#include "pull_analytics.h"
+#include "pull_audit.h"
+#include "pull_log.h"
+
+namespace {
+
+// Pull per potongan angka random/hasil, dan ukuran buffer keluaran sebelum ditulis
+const size_t CHUNK_PULLS = 4096;
+const size_t FLUSH_BYTES = 1 << 20;
+
+// Batas keluaran pemain yang sudah selesai tetapi belum gilirannya ditulis (mode banyak thread)
+const size_t WINDOW_BYTES = 64 << 20;
+
+typedef std::array<uint64_t, RARITY_COUNT> RarityCounts;
+
+bool parseNumber(std::string_view text, uint64_t& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+void appendNumber(std::string& buffer, uint64_t value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+// Field CSV, diberi kutip hanya jika berisi pemisah, kutip atau baris baru
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        return text;
+    }
+    std::string field = "\"";
+    for (char c : text) {
+        field += c;
+        if (c == '"') {
+            field += '"';
+        }
+    }
+    return field + "\"";
+}
+
+std::string jsonString(const std::string& text) {
+    std::string value = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            value += '\\';
+            value += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            value += escaped;
+        } else {
+            value += c;
+        }
+    }
+    return value + "\"";
+}
+
+// Format baris hasil pull. Bagian yang hanya bergantung pada karakter (ID, nama, rarity)
+// disiapkan sekali per karakter sehingga satu baris hanya berupa beberapa append
+class PullFormatter {
+private:
+    BatchFormat format;
+    std::vector<std::string> characterFields;   // Indeks = ID karakter
+    std::string itemFields[RARITY_COUNT];       // Pull tanpa karakter
+    uint32_t pityCharacter;                     // Kolom audit record biner
+    uint16_t catalogVersion;
+
+public:
+    PullFormatter(const GachaCatalog& catalog, BatchFormat outputFormat, uint32_t pityCharacterId) :
+        format(outputFormat),
+        pityCharacter(pityCharacterId),
+        catalogVersion(format == FORMAT_BIN ? catalog.fingerprint() : 0) {
+        characterFields.reserve(catalog.size());
+        for (uint32_t id = 0; id < catalog.size(); id++) {
+            std::string idText = std::to_string(id);
+            const char* rarity = rarityName(catalog.getRarity(id));
+            if (format == FORMAT_CSV) {
+                characterFields.push_back(idText + "," + csvField(catalog.getName(id)) + "," + rarity + ",");
+            } else {
+                characterFields.push_back("\"character_id\":" + idText + ",\"character\":" +
+                                          jsonString(catalog.getName(id)) + ",\"rarity\":\"" + rarity + "\",\"pity\":");
+            }
+        }
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            const char* rarity = rarityName(static_cast<Rarity>(i));
+            if (format == FORMAT_CSV) {
+                itemFields[i] = std::string(",,") + rarity + ",";
+            } else {
+                itemFields[i] = std::string("\"character_id\":null,\"character\":null,\"rarity\":\"") + rarity +
+                                "\",\"pity\":";
+            }
+        }
+    }
+    
+    // Awal keluaran: baris nama kolom (CSV) atau header catatan pull dengan seed dan engine random (biner)
+    void appendHeader(std::string& out, uint64_t seed, RngKind kind) const {
+        if (format == FORMAT_CSV) {
+            out += "player,pull,character_id,character,rarity,pity,pull_number\n";
+        } else if (format == FORMAT_BIN) {
+            char header[PullLog::HEADER_SIZE];
+            PullLog::writeHeader(header, seed, kind);
+            out.append(header, sizeof(header));
+        }
+    }
+    
+    // pullIndex dimulai dari 0 (kolom "pull" di teks dimulai dari 1); featuredState = state rate-up sebelum pull
+    void append(std::string& out, uint64_t player, uint64_t pullIndex, const GachaResult& result,
+                uint8_t featuredState) const {
+        if (format == FORMAT_BIN) {
+            PullLogRecord record = makePullLogRecord(player, pullIndex, result);
+            record.selectedCharPity = pityCharacter;
+            record.bannerVersion = catalogVersion;
+            record.featuredState = featuredState;
+            out.append(reinterpret_cast<const char*>(&record), sizeof(record));
+            return;
+        }
+        
+        const std::string& fields = result.characterId < characterFields.size() ?
+            characterFields[result.characterId] : itemFields[result.rarity < RARITY_COUNT ? result.rarity : RARITY_COMMON];
+        if (format == FORMAT_CSV) {
+            appendNumber(out, player);
+            out += ',';
+            appendNumber(out, pullIndex + 1);
+            out += ',';
+            out += fields;
+            out += result.isPity ? "1," : "0,";
+        } else {
+            out += "{\"player\":";
+            appendNumber(out, player);
+            out += ",\"pull\":";
+            appendNumber(out, pullIndex + 1);
+            out += ',';
+            out += fields;
+            out += result.isPity ? "true,\"pull_number\":" : "false,\"pull_number\":";
+        }
+        appendNumber(out, static_cast<uint64_t>(result.pullNumber));
+        out += format == FORMAT_CSV ? "\n" : "}\n";
+    }
+};
+
+bool writeBuffer(FILE* out, std::string& buffer) {
+    bool ok = buffer.empty() || std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+    buffer.clear();
+    return ok;
+}
+
+// Keluaran mode pull banyak thread, berurutan sesuai nomor pemain. Pemain terdepan menulis langsung setiap
+// FLUSH_BYTES; pemain lain yang buffernya penuh menunggu gilirannya, dan pemain yang sudah selesai ditampung
+// sampai WINDOW_BYTES. Memori tetap terbatas berapa pun jumlah pull per pemain
+class OrderedOutput {
+private:
+    FILE* out;
+    std::mutex mutex;
+    std::condition_variable turn;
+    uint64_t head;                              // Pemain yang sedang mendapat giliran menulis
+    std::map<uint64_t, std::string> finished;   // Pemain selesai yang menunggu giliran
+    size_t finishedBytes;
+    bool failed;
+    
+    // Menulis buffer pemain terdepan yang sudah selesai lalu pemain tertampung berikutnya (mutex dipegang)
+    void advance(std::string& buffer) {
+        failed = !writeBuffer(out, buffer) || failed;
+        head++;
+        for (auto next = finished.find(head); next != finished.end(); next = finished.find(head)) {
+            failed = !writeBuffer(out, next->second) || failed;
+            finishedBytes -= next->second.capacity();
+            finished.erase(next);
+            head++;
+        }
+        turn.notify_all();
+    }
+
+public:
+    explicit OrderedOutput(FILE* output) : out(output), head(0), finishedBytes(0), failed(false) {}
+    
+    // Buffer pemain yang belum selesai sudah penuh: menunggu giliran lalu menulisnya
+    bool write(uint64_t player, std::string& buffer) {
+        std::unique_lock<std::mutex> lock(mutex);
+        turn.wait(lock, [&] { return head == player || failed; });
+        if (!failed && !writeBuffer(out, buffer)) {
+            failed = true;
+            turn.notify_all();
+        }
+        return !failed;
+    }
+    
+    // Pemain selesai: ditulis jika gilirannya, ditampung jika masih muat, atau menunggu
+    bool finish(uint64_t player, std::string& buffer) {
+        std::unique_lock<std::mutex> lock(mutex);
+        turn.wait(lock, [&] {
+            return head == player || failed || finishedBytes + buffer.capacity() <= WINDOW_BYTES;
+        });
+        if (failed) {
+            return false;
+        }
+        if (head == player) {
+            advance(buffer);
+        } else {
+            finishedBytes += buffer.capacity();
+            finished[player].swap(buffer);
+        }
+        return !failed;
+    }
+    
+    // Menghentikan penulisan (pemain yang menunggu ikut berhenti)
+    void fail() {
+        std::lock_guard<std::mutex> lock(mutex);
+        failed = true;
+        turn.notify_all();
+    }
+};
+
+// Semua pull satu pemain ke buffer; flush(buffer) dipanggil setiap buffer mencapai FLUSH_BYTES
+template <typename Flush>
+bool runPlayer(const GachaCatalog& catalog, const PullFormatter& formatter, const BatchOptions& options,
+               uint32_t pityCharacter, uint64_t player, std::string& buffer, Flush flush, RarityCounts& counts) {
+    GachaRng rng;
+    rng.seed(options.rngKind, options.seed, player);
+    PityState state;
+    state.pullCount = 0;
+    state.selectedCharPity = pityCharacter;
+    state.featuredState = 0;
+    
+    double uniforms[2 * CHUNK_PULLS];
+    GachaResult results[CHUNK_PULLS];
+    for (uint64_t done = 0; done < options.pulls; ) {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(CHUNK_PULLS, options.pulls - done));
+        uint8_t featuredState = state.featuredState;
+        rng.fill(uniforms, 2 * count);
+        catalog.resolveBatch(state, uniforms, count, results);
+        for (size_t i = 0; i < count; i++) {
+            formatter.append(buffer, player, done + i, results[i], featuredState);
+            counts[results[i].rarity < RARITY_COUNT ? results[i].rarity : RARITY_COMMON]++;
+            if (results[i].rarity == RARITY_SSR) {
+                featuredState = catalog.nextFeaturedState(featuredState, results[i].characterId, pityCharacter);
+            }
+        }
+        done += count;
+        if (buffer.size() >= FLUSH_BYTES && !flush(buffer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Mode pull: pemain diambil thread berurutan, keluaran tetap berurutan sesuai nomor pemain
+bool runPulls(const GachaCatalog& catalog, const BatchOptions& options, uint32_t pityCharacter, unsigned threadCount,
+              FILE* out, RarityCounts& totals) {
+    PullFormatter formatter(catalog, options.format, pityCharacter);
+    std::string buffer;
+    formatter.appendHeader(buffer, options.seed, options.rngKind);
+    
+    if (threadCount <= 1) {
+        auto flush = [out](std::string& full) {
+            return writeBuffer(out, full);
+        };
+        for (uint64_t player = 0; player < options.players; player++) {
+            if (!runPlayer(catalog, formatter, options, pityCharacter, player, buffer, flush, totals)) {
+                return false;
+            }
+        }
+        return writeBuffer(out, buffer);
+    }
+    if (!writeBuffer(out, buffer)) {
+        return false;
+    }
+    
+    threadCount = static_cast<unsigned>(std::min<uint64_t>(threadCount, options.players));
+    OrderedOutput output(out);
+    std::atomic<uint64_t> nextPlayer(0);
+    std::atomic<bool> ok(true);
+    std::vector<RarityCounts> counts(threadCount, RarityCounts());
+    auto worker = [&](unsigned index) {
+        std::string playerBuffer;
+        for (uint64_t player = nextPlayer++; player < options.players && ok; player = nextPlayer++) {
+            auto flush = [&output, player](std::string& full) {
+                return output.write(player, full);
+            };
+            playerBuffer.clear();
+            if (!runPlayer(catalog, formatter, options, pityCharacter, player, playerBuffer, flush, counts[index]) ||
+                !output.finish(player, playerBuffer)) {
+                ok = false;
+                output.fail();
+            }
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threadCount; i++) {
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    
+    for (const RarityCounts& partial : counts) {
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            totals[i] += partial[i];
+        }
+    }
+    return ok;
+}
+
+// Mode simulasi: histogram pull sampai SSR pertama dan sampai karakter target, satu baris per jumlah pull
+bool runSimulation(const GachaCatalog& catalog, const BatchOptions& options, uint32_t pityCharacter,
+                   FILE* out, SimulationResult& simulation) {
+    SimulationConfig config;
+    config.trials = options.trials;
+    config.seed = options.seed;
+    config.rngKind = options.rngKind;
+    config.threads = options.threads;
+    config.targetCharacterId = pityCharacter;
+    config.pityCharacterId = pityCharacter;
+    simulation = GachaSimulator(catalog).run(config);
+    
+    std::string buffer = options.format == FORMAT_CSV ? "pulls,first_ssr,target\n" : "";
+    for (size_t pulls = 1; pulls < simulation.pullsToFirstSSR.size(); pulls++) {
+        uint64_t firstSSR = simulation.pullsToFirstSSR[pulls];
+        uint64_t target = simulation.pullsToTarget[pulls];
+        if (firstSSR == 0 && target == 0) {
+            continue;
+        }
+        buffer += options.format == FORMAT_CSV ? "" : "{\"pulls\":";
+        appendNumber(buffer, pulls);
+        buffer += options.format == FORMAT_CSV ? "," : ",\"first_ssr\":";
+        appendNumber(buffer, firstSSR);
+        buffer += options.format == FORMAT_CSV ? "," : ",\"target\":";
+        appendNumber(buffer, target);
+        buffer += options.format == FORMAT_CSV ? "\n" : "}\n";
+    }
+    return writeBuffer(out, buffer);
+}
+
+// Mode analisis: frekuensi per karakter ke keluaran, uji kecocokan rate dan statistik pity ke stderr
+bool runAnalysis(const GachaCatalog& catalog, const BatchOptions& options, FILE* out) {
+    PullLogAnalyzer analyzer(catalog);
+    PullLogStats stats;
+    bool loaded = false;
+    if (options.analyzePath == "-") {
+#ifdef _WIN32
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+        loaded = analyzer.analyzeStream(stdin, stats);
+    } else {
+        loaded = analyzer.analyzeFile(options.analyzePath, stats, options.threads);
+    }
+    if (!loaded) {
+        std::cerr << "Tidak bisa membaca catatan pull " << options.analyzePath << '\n';
+        return false;
+    }
+    
+    bool csv = options.format == FORMAT_CSV;
+    std::string buffer = csv ? "character_id,character,rarity,count,pity_count\n" : "";
+    for (uint32_t id = 0; id < catalog.size(); id++) {
+        buffer += csv ? "" : "{\"character_id\":";
+        appendNumber(buffer, id);
+        buffer += csv ? "," + csvField(catalog.getName(id)) + "," : ",\"character\":" + jsonString(catalog.getName(id)) +
+                  ",\"rarity\":\"";
+        buffer += rarityName(catalog.getRarity(id));
+        buffer += csv ? "," : "\",\"count\":";
+        appendNumber(buffer, stats.characterCounts[id]);
+        buffer += csv ? "," : ",\"pity_count\":";
+        appendNumber(buffer, stats.pityCharacterCounts[id]);
+        buffer += csv ? "\n" : "}\n";
+    }
+    if (!writeBuffer(out, buffer)) {
+        return false;
+    }
+    
+    std::cerr << stats.records << " record dianalisis, " << stats.skipped << " dilewati\n";
+    ChiSquareTest rarityTest = analyzer.rarityFit(stats);
+    std::cerr << "Uji rate rarity: chi2 = " << rarityTest.statistic << ", df = " << rarityTest.degrees
+              << ", p = " << rarityTest.pValue << '\n';
+    for (int i = 0; i < RARITY_COUNT; i++) {
+        ChiSquareTest test = analyzer.characterFit(stats, static_cast<Rarity>(i));
+        if (test.degrees > 0) {
+            std::cerr << "Uji rate karakter " << rarityName(static_cast<Rarity>(i)) << ": chi2 = " << test.statistic
+                      << ", df = " << test.degrees << ", p = " << test.pValue << '\n';
+        }
+    }
+    std::cerr << "SSR: " << stats.rarityCount(RARITY_SSR) << " (hard pity " << stats.pityPulls << ", soft pity "
+              << analyzer.softPitySSRShare(stats) * 100 << "%), rata-rata " << stats.meanPullsToSSR()
+              << " pull per SSR, kekeringan terpanjang " << stats.longestDrought() << " pull, SSR beruntun "
+              << stats.droughtCount(1) << '\n';
+    return true;
+}
+
+// Mode verifikasi: setiap record catatan pull diulang dari seed di header-nya dengan katalog banner,
+// ketidakcocokan ke keluaran dan ringkasannya ke stderr. clean = false jika ada yang tidak cocok
+bool runVerify(const GachaCatalog& catalog, const BatchOptions& options, FILE* out, bool& clean) {
+    PullLogVerifier verifier;
+    verifier.addCatalog(0, std::make_shared<GachaCatalog>(catalog));
+    AuditReport report;
+    if (!verifier.verifyFile(options.verifyPath, report, options.threads, options.verifyFrom)) {
+        std::cerr << "Tidak bisa memverifikasi catatan pull " << options.verifyPath
+                  << " (file tidak valid, catatan versi 1 tanpa seed, atau rng-nya bukan philox4x32)\n";
+        return false;
+    }
+    
+    bool csv = options.format == FORMAT_CSV;
+    std::string buffer = csv ? "record,player,pull,issue,expected_character_id,expected_rarity,expected_pity\n" : "";
+    for (const AuditDivergence& divergence : report.divergences) {
+        buffer += csv ? "" : "{\"record\":";
+        appendNumber(buffer, divergence.record);
+        buffer += csv ? "," : ",\"player\":";
+        appendNumber(buffer, divergence.playerId);
+        buffer += csv ? "," : ",\"pull\":";
+        appendNumber(buffer, divergence.pullIndex + 1);
+        buffer += csv ? "," : ",\"issue\":\"";
+        buffer += auditIssueName(divergence.issue);
+        const GachaResult& expected = divergence.expected;
+        if (divergence.issue != AUDIT_RESULT) {
+            buffer += csv ? ",,,\n" : "\"}\n";
+            continue;
+        }
+        buffer += csv ? "," : "\",\"expected_character_id\":";
+        if (expected.characterId == NO_CHARACTER) {
+            buffer += csv ? "" : "null";
+        } else {
+            appendNumber(buffer, expected.characterId);
+        }
+        buffer += csv ? "," : ",\"expected_rarity\":\"";
+        buffer += rarityName(expected.rarity);
+        buffer += csv ? (expected.isPity ? ",1\n" : ",0\n") : (expected.isPity ? "\",\"expected_pity\":true}\n" :
+                                                                   "\",\"expected_pity\":false}\n");
+    }
+    if (!writeBuffer(out, buffer)) {
+        return false;
+    }
+    
+    std::cerr << report.records << " record dari " << report.players << " pemain diverifikasi, "
+              << report.divergenceCount() << " tidak cocok";
+    for (int i = 0; i < AUDIT_ISSUE_COUNT; i++) {
+        if (report.issueCounts[i] > 0) {
+            std::cerr << ", " << auditIssueName(static_cast<AuditIssue>(i)) << " " << report.issueCounts[i];
+        }
+    }
+    std::cerr << '\n';
+    clean = report.clean();
+    return true;
+}
+
+}  // namespace
+
+bool parseBatchOptions(int argc, const char* const* argv, BatchOptions& options, std::string& error) {
+    for (int i = 1; i < argc; i++) {
+        std::string_view option = argv[i];
+        if (option == "--help" || option == "-h") {
+            options.help = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            error = "opsi " + std::string(option) + " tidak dikenal atau tidak punya nilai";
+            return false;
+        }
+        std::string_view value = argv[++i];
+        uint64_t number = 0;
+        bool valid = true;
+        
+        if (option == "--pulls") {
+            valid = parseNumber(value, options.pulls);
+        } else if (option == "--players") {
+            valid = parseNumber(value, options.players) && options.players > 0;
+        } else if (option == "--simulate") {
+            valid = parseNumber(value, options.trials) && options.trials > 0;
+        } else if (option == "--seed") {
+            valid = parseNumber(value, options.seed);
+            options.hasSeed = true;
+        } else if (option == "--threads") {
+            valid = parseNumber(value, number) && number <= 1024;
+            options.threads = static_cast<unsigned>(number);
+        } else if (option == "--rng") {
+            valid = false;
+            for (int kind = 0; kind < RNG_KIND_COUNT; kind++) {
+                if (value == rngKindName(static_cast<RngKind>(kind))) {
+                    options.rngKind = static_cast<RngKind>(kind);
+                    valid = true;
+                }
+            }
+        } else if (option == "--format") {
+            if (value == "csv") {
+                options.format = FORMAT_CSV;
+            } else if (value == "jsonl") {
+                options.format = FORMAT_JSONL;
+            } else if (value == "bin") {
+                options.format = FORMAT_BIN;
+            } else {
+                valid = false;
+            }
+        } else if (option == "--banner-file") {
+            options.bannerFile = value;
+        } else if (option == "--banner") {
+            options.bannerName = value;
+        } else if (option == "--pity") {
+            options.pityCharacter = value;
+        } else if (option == "--output") {
+            options.outputPath = value;
+        } else if (option == "--analyze") {
+            options.analyzePath = value;
+        } else if (option == "--verify") {
+            options.verifyPath = value;
+        } else if (option == "--from") {
+            valid = parseNumber(value, options.verifyFrom);
+        } else {
+            error = "opsi " + std::string(option) + " tidak dikenal";
+            return false;
+        }
+        
+        if (!valid) {
+            error = "nilai " + std::string(value) + " tidak valid untuk " + std::string(option);
+            return false;
+        }
+    }
+    
+    if ((options.trials > 0 || !options.analyzePath.empty() || !options.verifyPath.empty()) &&
+        options.format == FORMAT_BIN) {
+        error = "format bin hanya untuk mode pull, bukan --simulate, --analyze atau --verify";
+        return false;
+    }
+    return true;
+}
+
+const char* batchUsage() {
+    return "Mode batch (tanpa menu):\n"
+           "  --pulls N          pull per pemain (bawaan 10)\n"
+           "  --players N        pemain independen, masing-masing dengan pity dan stream random sendiri (bawaan 1)\n"
+           "  --simulate N       simulasi N pemain sampai SSR/karakter pity, keluarannya histogram\n"
+           "  --seed N           seed utama (bawaan acak, dicetak di ringkasan)\n"
+           "  --rng NAMA         mt19937 | xoshiro256** | pcg64 | philox4x32 (bawaan philox4x32)\n"
+           "  --threads N        0 = semua core (bawaan 0)\n"
+           "  --format F         csv | jsonl | bin (bin = format catatan pull, hanya mode pull)\n"
+           "  --banner-file P    file definisi banner\n"
+           "  --banner NAMA      banner di file (bawaan banner pertama)\n"
+           "  --pity NAMA        karakter pity/target SSR (bawaan karakter ID 0)\n"
+           "  --output P         file keluaran (bawaan stdout)\n"
+           "  --analyze P        analisis file catatan pull (- = stdin) terhadap banner: frekuensi per karakter,\n"
+           "                     uji chi-square rate, statistik pity dan kekeringan SSR\n"
+           "  --verify P         ulang setiap pull di file catatan pull (rng philox4x32) dengan banner dan seed\n"
+           "                     di header-nya, keluarannya record yang tidak cocok (kode keluar 1 jika ada)\n"
+           "  --from N           --verify mulai record ke-N tanpa mengulang record sebelumnya (bawaan 0)\n";
+}
+
+int runBatch(const BatchOptions& options) {
+    std::vector<BannerDefinition> banners;
+    std::string error;
+    if (!loadBannerFile(options.bannerFile, banners, error)) {
+        std::cerr << "Konfigurasi banner: " << error << '\n';
+        return 1;
+    }
+    const BannerDefinition* banner = options.bannerName.empty() ? &banners.front() :
+        findBanner(banners, options.bannerName);
+    if (!banner) {
+        std::cerr << "Banner " << options.bannerName << " tidak ada di " << options.bannerFile << '\n';
+        return 1;
+    }
+    const GachaCatalog& catalog = banner->catalog;
+    
+    uint32_t pityCharacter = 0;
+    if (!options.pityCharacter.empty()) {
+        int index = catalog.findSSRCharacter(options.pityCharacter);
+        if (index < 0) {
+            std::cerr << "Karakter SSR " << options.pityCharacter << " tidak ada di banner " << banner->name << '\n';
+            return 1;
+        }
+        pityCharacter = static_cast<uint32_t>(index);
+    }
+    
+    BatchOptions run = options;
+    if (!run.hasSeed) {
+        std::random_device rd;
+        run.seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+    unsigned threadCount = run.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : run.threads;
+    threadCount = static_cast<unsigned>(std::min<uint64_t>(threadCount, run.players));
+    
+    FILE* out = stdout;
+    if (!run.outputPath.empty() && run.outputPath != "-") {
+        out = std::fopen(run.outputPath.c_str(), "wb");
+        if (!out) {
+            std::cerr << "Tidak bisa membuka " << run.outputPath << ": " << std::strerror(errno) << '\n';
+            return 1;
+        }
+    } else {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    }
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!run.verifyPath.empty()) {
+        bool clean = false;
+        bool verified = runVerify(catalog, run, out, clean) && std::fflush(out) == 0;
+        if (out != stdout) {
+            verified = std::fclose(out) == 0 && verified;
+        }
+        std::cerr << "Banner " << banner->name << " ("
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s)\n";
+        return verified && clean ? 0 : 1;
+    }
+    if (!run.analyzePath.empty()) {
+        bool analyzed = runAnalysis(catalog, run, out) && std::fflush(out) == 0;
+        if (out != stdout) {
+            analyzed = std::fclose(out) == 0 && analyzed;
+        }
+        std::cerr << "Banner " << banner->name << " ("
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s)\n";
+        return analyzed ? 0 : 1;
+    }
+    
+    RarityCounts counts = RarityCounts();
+    SimulationResult simulation;
+    bool ok = run.trials > 0 ? runSimulation(catalog, run, pityCharacter, out, simulation) :
+        runPulls(catalog, run, pityCharacter, threadCount, out, counts);
+    ok = std::fflush(out) == 0 && ok;
+    if (out != stdout) {
+        ok = std::fclose(out) == 0 && ok;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        std::cerr << "Gagal menulis keluaran batch\n";
+        return 1;
+    }
+    
+    // Ringkasan ke stderr agar stdout hanya berisi data
+    std::cerr << "Banner " << banner->name << ", seed " << run.seed << ", rng " << rngKindName(run.rngKind) << '\n';
+    if (run.trials > 0) {
+        std::cerr << "Simulasi " << run.trials << " pemain: rata-rata " << SimulationResult::mean(simulation.pullsToFirstSSR)
+                  << " pull sampai SSR, " << SimulationResult::mean(simulation.pullsToTarget) << " pull sampai "
+                  << catalog.getName(pityCharacter) << " (" << seconds << " s)\n";
+        return 0;
+    }
+    uint64_t total = run.pulls * run.players;
+    std::cerr << total << " pull (" << run.players << " pemain x " << run.pulls << ") dalam " << seconds << " s";
+    if (seconds > 0) {
+        std::cerr << " = " << static_cast<uint64_t>(total / seconds) << " pull/detik";
+    }
+    std::cerr << '\n';
+    for (int i = 0; i < RARITY_COUNT; i++) {
+        std::cerr << rarityName(static_cast<Rarity>(i)) << ": " << counts[i];
+        std::cerr << (i + 1 < RARITY_COUNT ? ", " : "\n");
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#ifndef GACHA_BATCH_RUNNER_H
+#define GACHA_BATCH_RUNNER_H
+
+#include <cstdint>
+#include <string>
+
+#include "gacha_rng.h"
+
+// Format keluaran mode batch
+enum BatchFormat : uint8_t {
+    FORMAT_CSV = 0,     // Teks dengan baris header kolom
+    FORMAT_JSONL = 1,   // Satu objek JSON per baris
+    FORMAT_BIN = 2      // Header + PullLogRecord 32 byte, formatnya sama dengan file catatan pull
+};
+
+// Opsi mode batch: pull atau simulasi tanpa menu, tanpa input terminal dan tanpa proses lain
+struct BatchOptions {
+    uint64_t pulls;             // Pull per pemain
+    uint64_t players;           // Pemain independen, masing-masing dengan pity dan stream random sendiri
+    uint64_t trials;            // > 0 = simulasi Monte Carlo sebanyak ini, keluarannya histogram
+    uint64_t seed;
+    bool hasSeed;               // false = seed acak (dicetak di ringkasan agar bisa diulang)
+    RngKind rngKind;
+    unsigned threads;           // 0 = semua core
+    BatchFormat format;
+    std::string bannerFile;
+    std::string bannerName;     // Kosong = banner pertama di file
+    std::string pityCharacter;  // Karakter pity/target, kosong = ID 0 seperti pemain baru
+    std::string outputPath;     // Kosong atau "-" = stdout
+    std::string analyzePath;    // Diisi = analisis file catatan pull ("-" = stdin), keluarannya frekuensi per karakter
+    std::string verifyPath;     // Diisi = verifikasi ulang file catatan pull, keluarannya record yang tidak cocok
+    uint64_t verifyFrom;        // Record pertama yang diverifikasi
+    bool help;
+    
+    BatchOptions() :
+        pulls(10),
+        players(1),
+        trials(0),
+        seed(0),
+        hasSeed(false),
+        rngKind(RNG_PHILOX4X32),
+        threads(0),
+        format(FORMAT_CSV),
+        verifyFrom(0),
+        help(false) {}
+};
+
+// Parsing argv[1..argc) ke options (nilai yang sudah ada di options menjadi bawaan).
+// False dengan pesan di error jika ada opsi yang tidak dikenal atau nilainya tidak valid
+bool parseBatchOptions(int argc, const char* const* argv, BatchOptions& options, std::string& error);
+
+// Teks bantuan semua opsi
+const char* batchUsage();
+
+// Menjalankan mode batch. Hasil per pemain hanya bergantung pada seed dan nomor pemain, bukan jumlah thread.
+// Ringkasan (jumlah pull, waktu, pull/detik) ditulis ke stderr; mengembalikan kode keluar proses
+int runBatch(const BatchOptions& options);
+
+#endif // GACHA_BATCH_RUNNER_H
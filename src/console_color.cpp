@@ -0,0 +1,58 @@
+#include "console_color.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Fungsi untuk mengatur warna konsol (Windows)
+void setConsoleColor(ConsoleColor textColor, ConsoleColor bgColor) {
+#ifdef _WIN32
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    SetConsoleTextAttribute(hConsole, (bgColor << 4) | textColor);
+#else
+    // Untuk sistem UNIX/Linux, gunakan ANSI escape codes (warna latar tidak dipakai)
+    (void)bgColor;
+    std::cout << ansiColorCode(textColor);
+#endif
+}
+
+const char* ansiColorCode(ConsoleColor textColor) {
+    switch(textColor) {
+        case BLACK: return "\033[30m";
+        case RED: return "\033[31m";
+        case GREEN: return "\033[32m";
+        case YELLOW: return "\033[33m";
+        case BLUE: return "\033[34m";
+        case MAGENTA: return "\033[35m";
+        case CYAN: return "\033[36m";
+        case WHITE: return "\033[37m";
+        default: return ANSI_RESET;
+    }
+}
+
+bool enableAnsiColors() {
+#ifdef _WIN32
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (!GetConsoleMode(hConsole, &mode)) {
+        return false;
+    }
+    return SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+#else
+    return true;
+#endif
+}
+
+// Fungsi untuk mereset warna konsol
+void resetConsoleColor() {
+#ifdef _WIN32
+    setConsoleColor(WHITE, BLACK);
+#else
+    std::cout << "\033[0m";
+#endif
+}
@@ -0,0 +1,30 @@
+#ifndef GACHA_CONSOLE_COLOR_H
+#define GACHA_CONSOLE_COLOR_H
+
+// Enumerasi untuk warna konsol (Windows)
+enum ConsoleColor {
+    BLACK = 0,
+    BLUE = 1,
+    GREEN = 2,
+    CYAN = 3,
+    RED = 4,
+    MAGENTA = 5,
+    YELLOW = 6,
+    WHITE = 7,
+    BRIGHT = 8
+};
+
+// Fungsi untuk mengatur warna konsol (Windows)
+void setConsoleColor(ConsoleColor textColor, ConsoleColor bgColor = BLACK);
+
+// Fungsi untuk mereset warna konsol
+void resetConsoleColor();
+
+// Kode escape ANSI untuk warna teks, untuk teks yang disusun di buffer sebelum ditulis
+const char* ansiColorCode(ConsoleColor textColor);
+const char* const ANSI_RESET = "\033[0m";
+
+// Mengaktifkan kode ANSI di konsol (Windows 10 ke atas), false jika konsol tidak mendukung
+bool enableAnsiColors();
+
+#endif // GACHA_CONSOLE_COLOR_H
@@ -0,0 +1,136 @@
+#include "gacha_async.h"
+
+#include <algorithm>
+
+GachaExecutor::GachaExecutor(size_t threads) : stopping(false) {
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        workers.emplace_back([this] { run(); });
+    }
+}
+
+GachaExecutor::~GachaExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    while (runOne(false)) {
+    }
+}
+
+void GachaExecutor::post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(handle);
+    }
+    ready.notify_one();
+}
+
+bool GachaExecutor::runOne(bool wait) {
+    std::coroutine_handle<> handle;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (wait) {
+            ready.wait(lock, [this] { return stopping || !queue.empty(); });
+        }
+        if (queue.empty()) {
+            return false;
+        }
+        handle = queue.front();
+        queue.pop_front();
+    }
+    handle.resume();
+    return true;
+}
+
+size_t GachaExecutor::poll() {
+    // Hanya yang sudah antre saat dipanggil, agar coroutine yang terus mem-post tidak menahan event loop
+    size_t pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = queue.size();
+    }
+    size_t done = 0;
+    while (done < pending && runOne(false)) {
+        done++;
+    }
+    return done;
+}
+
+// Sisa antrean tetap dijalankan saat ditutup, baru thread berhenti
+void GachaExecutor::run() {
+    while (runOne(true)) {
+    }
+}
+
+void GachaStrand::LockAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(strand.mutex);
+        if (strand.busy) {
+            strand.waiting.push_back(handle);
+            return;
+        }
+        strand.busy = true;
+    }
+    strand.executor.post(handle);
+}
+
+void GachaStrand::unlock() {
+    std::coroutine_handle<> next;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (waiting.empty()) {
+            busy = false;
+            return;
+        }
+        next = waiting.front();
+        waiting.pop_front();
+    }
+    executor.post(next);
+}
+
+AsyncGachaServer::AsyncGachaServer(GachaServer& gachaServer, GachaExecutor& executorValue, size_t strandTotal) :
+    server(gachaServer),
+    executor(executorValue) {
+    for (size_t i = 0; i < std::max<size_t>(1, strandTotal); i++) {
+        strands.emplace_back(executor);
+    }
+}
+
+Task<std::optional<GachaResult>> AsyncGachaServer::pull(uint64_t playerId, uint32_t bannerId) {
+    GachaStrand::Guard guard = co_await strandOf(playerId).lock();
+    GachaResult result;
+    if (!server.pull(playerId, bannerId, &result, 1)) {
+        co_return std::nullopt;
+    }
+    co_return result;
+}
+
+Task<std::vector<GachaResult>> AsyncGachaServer::multiPull(uint64_t playerId, uint32_t bannerId, int count) {
+    GachaStrand::Guard guard = co_await strandOf(playerId).lock();
+    co_return server.multiPull(playerId, bannerId, count);
+}
+
+Task<bool> AsyncGachaServer::setSelectedCharPity(uint64_t playerId, uint32_t bannerId, uint32_t characterId) {
+    GachaStrand::Guard guard = co_await strandOf(playerId).lock();
+    co_return server.setSelectedCharPity(playerId, bannerId, characterId);
+}
+
+Task<PityState> AsyncGachaServer::getPityState(uint64_t playerId, uint32_t bannerId) {
+    GachaStrand::Guard guard = co_await strandOf(playerId).lock();
+    co_return server.getPityState(playerId, bannerId);
+}
+
+Task<bool> AsyncGachaServer::saveSnapshot(std::string path) {
+    co_await executor.schedule();
+    co_return server.saveSnapshot(path);
+}
+
+Task<void> AsyncGachaServer::flushLog() {
+    co_await executor.schedule();
+    server.flushLog();
+}
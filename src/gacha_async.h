@@ -0,0 +1,383 @@
+#ifndef GACHA_ASYNC_H
+#define GACHA_ASYNC_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gacha_server.h"
+#include "gacha_types.h"
+
+template <typename T>
+class Task;
+
+// Bagian promise yang sama untuk Task<T> dan Task<void>
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;   // Coroutine yang menunggu hasil (kosong = belum ada)
+    std::exception_ptr error;
+    
+    // Selesai: langsung lanjut ke coroutine pemanggil (symmetric transfer, stack tidak menumpuk)
+    struct FinalAwaiter {
+        bool await_ready() noexcept {
+            return false;
+        }
+        
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            std::coroutine_handle<> next = handle.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        
+        void await_resume() noexcept {}
+    };
+    
+    std::suspend_always initial_suspend() noexcept {
+        return {};
+    }
+    
+    FinalAwaiter final_suspend() noexcept {
+        return {};
+    }
+    
+    void unhandled_exception() {
+        error = std::current_exception();
+    }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+    
+    void return_value(T result) {
+        value.emplace(std::move(result));
+    }
+    
+    T result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    void return_void() {}
+    
+    void result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+// Hasil coroutine yang lazy: baru berjalan saat di-co_await (atau lewat GachaExecutor::spawn/syncWait),
+// lalu melanjutkan coroutine yang menunggunya begitu selesai. Hanya bisa dipindah, tidak disalin
+template <typename T>
+class Task {
+public:
+    struct promise_type : TaskPromise<T> {
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+    
+    explicit Task(std::coroutine_handle<promise_type> handleValue) : handle(handleValue) {}
+
+public:
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+    
+    bool await_ready() const noexcept {
+        return !handle || handle.done();
+    }
+    
+    // Menyimpan pemanggil sebagai lanjutan lalu langsung menjalankan coroutine ini
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle.promise().continuation = caller;
+        return handle;
+    }
+    
+    T await_resume() {
+        return handle.promise().result();
+    }
+};
+
+// Executor lokal kecil: antrean coroutine yang dijalankan thread pekerja sendiri.
+// Dengan 0 thread, antrean hanya dijalankan lewat poll() dari event loop pemanggil
+class GachaExecutor {
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::coroutine_handle<>> queue;
+    bool stopping;
+    std::vector<std::thread> workers;
+    
+    // Coroutine lepas yang menghapus dirinya sendiri setelah selesai (dipakai spawn())
+    struct Detached {
+        struct promise_type {
+            Detached get_return_object() {
+                return {};
+            }
+            
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+            
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+            
+            void return_void() {}
+            
+            void unhandled_exception() {
+                std::terminate();
+            }
+        };
+    };
+    
+    template <typename T, typename Callback>
+    static Detached runDetached(Task<T> task, Callback done) {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            done();
+        } else {
+            done(co_await std::move(task));
+        }
+    }
+    
+    // Mengambil satu coroutine dari antrean (menunggu jika wait = true) lalu menjalankannya
+    bool runOne(bool wait);
+    
+    void run();
+
+public:
+    explicit GachaExecutor(size_t threads = std::thread::hardware_concurrency());
+    
+    // Menjalankan sisa antrean lalu menghentikan thread pekerja
+    ~GachaExecutor();
+    
+    GachaExecutor(const GachaExecutor&) = delete;
+    GachaExecutor& operator=(const GachaExecutor&) = delete;
+    
+    size_t threadCount() const {
+        return workers.size();
+    }
+    
+    // Menaruh coroutine di antrean untuk dilanjutkan oleh executor
+    void post(std::coroutine_handle<> handle);
+    
+    // Menjalankan coroutine yang sedang antre di thread pemanggil, mengembalikan jumlahnya.
+    // Untuk executor 0 thread dipanggil dari event loop; dengan thread pekerja pemanggil ikut membantu
+    size_t poll();
+    
+    // co_await executor.schedule() memindahkan sisa coroutine ke executor
+    struct ScheduleAwaiter {
+        GachaExecutor& executor;
+        
+        bool await_ready() const noexcept {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> handle) {
+            executor.post(handle);
+        }
+        
+        void await_resume() const noexcept {}
+    };
+    
+    ScheduleAwaiter schedule() {
+        return ScheduleAwaiter{ *this };
+    }
+    
+    // Memulai task tanpa menunggu; done(hasil) (atau done() untuk Task<void>) dipanggil di thread
+    // yang menyelesaikannya. Task berjalan di thread pemanggil sampai suspend pertamanya
+    template <typename T, typename Callback>
+    void spawn(Task<T> task, Callback done) {
+        runDetached(std::move(task), std::move(done));
+    }
+    
+    template <typename T>
+    void spawn(Task<T> task) {
+        if constexpr (std::is_void_v<T>) {
+            spawn(std::move(task), [] {});
+        } else {
+            spawn(std::move(task), [](T) {});
+        }
+    }
+    
+    // Menjalankan task dan memblok sampai hasilnya ada (untuk kode sinkron dan tes).
+    // Executor 0 thread dijalankan di thread ini selama menunggu
+    template <typename T>
+    T syncWait(Task<T> task) {
+        std::mutex doneMutex;
+        std::condition_variable doneReady;
+        bool finished = false;
+        std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+        
+        auto finish = [&] {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            finished = true;
+            doneReady.notify_one();
+        };
+        if constexpr (std::is_void_v<T>) {
+            spawn(std::move(task), finish);
+        } else {
+            spawn(std::move(task), [&](T result) {
+                value.emplace(std::move(result));
+                finish();
+            });
+        }
+        
+        if (workers.empty()) {
+            while (true) {
+                {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    if (finished) {
+                        break;
+                    }
+                }
+                runOne(true);
+            }
+        } else {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            doneReady.wait(lock, [&] { return finished; });
+        }
+        
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*value);
+        }
+    }
+};
+
+// Urutan per kunci di atas executor: coroutine yang memegang strand yang sama berjalan satu per satu
+// sesuai urutan lock(), sedangkan strand berbeda berjalan paralel di thread pekerja
+class GachaStrand {
+private:
+    GachaExecutor& executor;
+    std::mutex mutex;
+    std::deque<std::coroutine_handle<>> waiting;
+    bool busy;
+
+public:
+    explicit GachaStrand(GachaExecutor& executorValue) : executor(executorValue), busy(false) {}
+    
+    GachaStrand(const GachaStrand&) = delete;
+    GachaStrand& operator=(const GachaStrand&) = delete;
+    
+    // Melepas strand saat keluar scope
+    class Guard {
+    private:
+        GachaStrand* strand;
+    
+    public:
+        explicit Guard(GachaStrand* strandValue) : strand(strandValue) {}
+        
+        Guard(Guard&& other) noexcept : strand(std::exchange(other.strand, nullptr)) {}
+        
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+        
+        ~Guard() {
+            if (strand) {
+                strand->unlock();
+            }
+        }
+    };
+    
+    // co_await strand.lock(): dilanjutkan di executor ketika giliran coroutine ini tiba
+    struct LockAwaiter {
+        GachaStrand& strand;
+        
+        bool await_ready() const noexcept {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> handle);
+        
+        Guard await_resume() noexcept {
+            return Guard(&strand);
+        }
+    };
+    
+    LockAwaiter lock() {
+        return LockAwaiter{ *this };
+    }
+    
+    // Memberikan strand ke coroutine berikutnya di antrean (atau menandainya bebas)
+    void unlock();
+};
+
+// Antarmuka coroutine untuk GachaServer bagi frontend berbasis event loop.
+// Operasi satu pemain dijalankan berurutan sesuai urutan pemanggilan (strand per pemain,
+// pemain id memakai strand id % jumlah strand), sedangkan permintaan pemain lain berjalan
+// bersamaan di executor sehingga pull, penulisan snapshot dan catatan pull saling tumpang tindih.
+// Urutan berlaku untuk operasinya; lanjutan/callback dua operasi berurutan bisa berjalan bersamaan
+class AsyncGachaServer {
+private:
+    GachaServer& server;
+    GachaExecutor& executor;
+    std::deque<GachaStrand> strands;
+    
+    GachaStrand& strandOf(uint64_t playerId) {
+        return strands[playerId % strands.size()];
+    }
+
+public:
+    AsyncGachaServer(GachaServer& gachaServer, GachaExecutor& executorValue, size_t strandTotal = 1024);
+    
+    GachaExecutor& getExecutor() {
+        return executor;
+    }
+    
+    // Satu pull, kosong jika ID pemain atau banner tidak dikenal
+    Task<std::optional<GachaResult>> pull(uint64_t playerId, uint32_t bannerId = 0);
+    
+    // count pull sekaligus, vector kosong jika ID pemain atau banner tidak dikenal
+    Task<std::vector<GachaResult>> multiPull(uint64_t playerId, uint32_t bannerId, int count);
+    
+    Task<bool> setSelectedCharPity(uint64_t playerId, uint32_t bannerId, uint32_t characterId);
+    
+    // State pity setelah semua operasi pemain ini yang dipanggil sebelumnya selesai
+    Task<PityState> getPityState(uint64_t playerId, uint32_t bannerId = 0);
+    
+    // Snapshot semua pemain ditulis di executor; operasi yang masih antre di strand belum ikut tersimpan
+    Task<bool> saveSnapshot(std::string path);
+    
+    // Menulis record yang tertampung ke catatan pull di executor
+    Task<void> flushLog();
+};
+
+#endif // GACHA_ASYNC_H
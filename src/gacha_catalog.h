@@ -0,0 +1,1025 @@
+#ifndef GACHA_CATALOG_H
+#define GACHA_CATALOG_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "alias_table.h"
+#include "gacha_types.h"
+#include "rarity_kernel.h"
+#include "snapshot.h"
+
+// Metadata tampilan karakter yang jarang dibaca, disimpan terpisah dari kolom rarity dan rate
+struct CharacterInfo {
+    std::string title;
+    std::string element;
+};
+
+// Sampler per rarity: karakter aktif, rate-nya, dan tabel alias yang dikompilasi dari keduanya.
+// Sekaligus menjadi partisi katalog per rarity (ID dan rate aktif yang bersebelahan di memori)
+struct RaritySampler {
+    std::vector<uint32_t> members;   // ID karakter aktif (urutan bebas, hapus = tukar dengan elemen terakhir)
+    std::vector<double> weights;     // Rate anggota, sejajar dengan members
+    AliasTable table;
+    bool dirty;                      // Anggota atau rate berubah sejak tabel terakhir dibangun
+    
+    RaritySampler() : dirty(false) {}
+};
+
+// State pity per pemain (kecil, dipisah dari katalog yang dipakai bersama)
+struct PityState {
+    int32_t pullCount;          // Jumlah pull sejak SSR terakhir
+    uint32_t selectedCharPity;  // Indeks karakter yang akan didapat saat pity (karakter pilihan di banner rate-up)
+    uint8_t featuredState;      // Indeks state mesin rate-up (0 = awal, diabaikan banner tanpa rate-up)
+};
+
+// Batas streak kalah untuk capture dan jumlah fate point, agar semua state rate-up muat dalam 8-bit
+const int MAX_FEATURED_STREAK = 7;
+
+// Aturan rate-up banner: peluang 50/50, garansi setelah kalah, capture (peluang naik setelah
+// kalah beruntun) dan epitomized path (fate point menuju karakter pilihan)
+struct FeaturedRules {
+    double featuredChance;      // Peluang SSR jatuh ke karakter featured (0.5 = 50/50)
+    bool guaranteeAfterLoss;    // Kalah 50/50 membuat SSR berikutnya pasti featured
+    int captureStreak;          // Setelah kalah beruntun sebanyak ini peluangnya captureChance (0 = tanpa capture)
+    double captureChance;
+    int fatePoints;             // SSR bukan karakter pilihan sebanyak ini membuat SSR berikutnya pasti karakter pilihan (0 = tanpa)
+    
+    FeaturedRules() : featuredChance(0.5), guaranteeAfterLoss(true), captureStreak(0), captureChance(1.0), fatePoints(0) {}
+};
+
+// Hasil SSR di mesin rate-up, sekaligus indeks transisi FeaturedState::next
+enum FeaturedOutcome : uint8_t {
+    FEATURED_LOSE = 0,      // SSR standar (kalah 50/50)
+    FEATURED_WIN = 1,       // SSR featured selain karakter pilihan
+    FEATURED_TARGET = 2,    // SSR featured yang merupakan karakter pilihan
+    FEATURED_OUTCOME_COUNT = 3
+};
+
+// Satu state mesin rate-up yang sudah dikompilasi; state = (garansi, streak kalah, fate point)
+struct FeaturedState {
+    double featuredChance;                  // Peluang SSR featured di state ini
+    bool forceTarget;                       // Fate point penuh: SSR berikutnya pasti karakter pilihan
+    bool guaranteed;                        // Garansi featured setelah kalah 50/50 (untuk ditampilkan)
+    uint8_t next[FEATURED_OUTCOME_COUNT];   // State berikutnya per FeaturedOutcome
+};
+
+// Bentuk kurva soft pity
+enum SoftPityKind : uint8_t {
+    SOFT_PITY_MULTIPLY = 0,     // Rate SSR dikali faktor tetap (lalu dinormalisasi)
+    SOFT_PITY_LINEAR = 1,       // Peluang SSR naik sebesar value setiap pull
+    SOFT_PITY_TABLE = 2         // Peluang SSR per pull diambil dari tabel
+};
+
+// Kurva soft pity mulai counter softPityStart, dikompilasi menjadi tabel batas rarity per counter
+struct SoftPityCurve {
+    SoftPityKind kind;
+    double value;               // MULTIPLY: faktor rate SSR (> 1); LINEAR: tambahan peluang SSR per pull (> 0)
+    std::vector<double> rates;  // TABLE: peluang SSR pada counter softPityStart, +1, ... (sisanya memakai nilai terakhir)
+    
+    SoftPityCurve() : kind(SOFT_PITY_MULTIPLY), value(5.0) {}
+    
+    static SoftPityCurve multiply(double boost) {
+        SoftPityCurve curve;
+        curve.value = boost;
+        return curve;
+    }
+    
+    static SoftPityCurve linear(double step) {
+        SoftPityCurve curve;
+        curve.kind = SOFT_PITY_LINEAR;
+        curve.value = step;
+        return curve;
+    }
+    
+    static SoftPityCurve table(std::vector<double> chances) {
+        SoftPityCurve curve;
+        curve.kind = SOFT_PITY_TABLE;
+        curve.value = 0.0;
+        curve.rates = std::move(chances);
+        return curve;
+    }
+    
+    // True jika parameter kurva masuk akal
+    bool valid() const {
+        switch (kind) {
+        case SOFT_PITY_MULTIPLY:
+            return value > 1.0 && std::isfinite(value);
+        case SOFT_PITY_LINEAR:
+            return value > 0.0 && value <= 1.0;
+        case SOFT_PITY_TABLE:
+            if (rates.empty() || rates.size() > static_cast<size_t>(MAX_HARD_PITY)) {
+                return false;
+            }
+            for (double chance : rates) {
+                if (!(chance >= 0.0 && chance <= 1.0)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+// Selisih maksimum jumlah rate rarity dari 1 (galat pembulatan angka desimal di file konfigurasi)
+const double RATE_SUM_TOLERANCE = 1e-9;
+
+// Flag karakter di snapshot (versi 2 ke atas)
+const uint8_t CHARACTER_REMOVED_FLAG = 0x01;
+
+// Katalog banner: karakter, rate, pengaturan pity dan sampler yang sudah dikompilasi.
+// Tidak menyimpan state pemain, sehingga satu katalog bisa dipakai bersama oleh banyak pemain/thread.
+// Perubahan karakter (tambah, hapus, ubah rate) O(1) dan hanya menandai sampler rarity-nya kotor;
+// tabel alias dibangun ulang sekali di compile(), yang wajib dipanggil sebelum katalog dipakai untuk pull
+class GachaCatalog {
+private:
+    // Panjang jendela klasifikasi spekulatif; sisa jendela dibuang saat counter reset
+    static constexpr size_t SPECULATION_WINDOW = 32;
+    
+    // Posisi sampler untuk karakter yang sudah dihapus
+    static constexpr uint32_t REMOVED_POSITION = 0xFFFFFFFFu;
+    
+    // Kolom karakter (indeks = ID); karakter terhapus tetap ada agar ID tidak bergeser.
+    // Kolom rarity dan rate yang sering dipindai dipisah dari string nama dan metadata tampilan
+    std::vector<Rarity> characterRarities;
+    std::vector<double> characterRates;
+    std::vector<std::string> characterNames;
+    std::vector<CharacterInfo> characterInfos;
+    std::vector<uint32_t> memberPositions; // Posisi karakter di samplers[rarity].members, atau REMOVED_POSITION
+    int hardPity;           // Garansi SSR (biasanya 100)
+    int softPityStart;      // Kapan soft pity mulai (biasanya 75)
+    SoftPityCurve softPityCurve; // Kenaikan rate SSR mulai softPityStart
+    double rarityRates[RARITY_COUNT]; // Rate untuk setiap rarity
+    
+    // Cache untuk total rate karakter aktif setiap rarity (diperbarui setiap perubahan)
+    double totalRarityRates[RARITY_COUNT];
+    
+    // Sampler untuk setiap rarity
+    RaritySampler samplers[RARITY_COUNT];
+    bool dirty;   // Ada sampler yang perlu dibangun ulang
+    uint64_t revision;  // Bertambah setiap perubahan yang bisa mengubah hasil pull (untuk cache sidik katalog)
+    
+    // Batas rarity per nilai counter 0..hardPity (counter setelah ditambah 1), dihitung ulang saat pengaturan berubah
+    std::vector<RarityThresholds> thresholds;
+    
+    // Rate-up: konfigurasi, lalu hasil kompilasinya (pool SSR featured dan standar serta tabel state)
+    std::vector<uint32_t> featuredIds;
+    FeaturedRules featuredRules;
+    bool featuredDirty;
+    std::vector<uint8_t> featuredFlags;         // Indeks = ID karakter, 1 jika karakter featured aktif
+    RaritySampler featuredPool;
+    RaritySampler standardPool;
+    std::vector<FeaturedState> featuredStates;  // Kosong = banner tanpa rate-up
+    
+    void markDirty(Rarity rarity) {
+        samplers[rarity].dirty = true;
+        dirty = true;
+        revision++;
+    }
+    
+    // Menambah karakter ke akhir katalog dan ke sampler rarity-nya (O(1) amortisasi)
+    uint32_t insertCharacter(Character character) {
+        uint32_t characterId = static_cast<uint32_t>(characterRarities.size());
+        RaritySampler& sampler = samplers[character.rarity];
+        memberPositions.push_back(static_cast<uint32_t>(sampler.members.size()));
+        sampler.members.push_back(characterId);
+        sampler.weights.push_back(character.rate);
+        totalRarityRates[character.rarity] += character.rate;
+        markDirty(character.rarity);
+        characterRarities.push_back(character.rarity);
+        characterRates.push_back(character.rate);
+        characterNames.push_back(std::move(character.name));
+        characterInfos.push_back(CharacterInfo{ std::move(character.title), std::move(character.element) });
+        return characterId;
+    }
+    
+    // Bangun ulang tabel alias satu rarity; total dijumlah ulang agar galat penjumlahan bertahap tidak menumpuk
+    void rebuildSampler(Rarity rarity) {
+        RaritySampler& sampler = samplers[rarity];
+        sampler.table.build(sampler.weights);
+        
+        double total = 0.0;
+        for (double weight : sampler.weights) {
+            total += weight;
+        }
+        totalRarityRates[rarity] = total;
+        sampler.dirty = false;
+    }
+    
+    // Peluang SSR kurva LINEAR/TABLE pada counter tertentu (counter >= softPityStart)
+    double softPityChance(int counter) const {
+        int step = counter - softPityStart;
+        if (softPityCurve.kind == SOFT_PITY_LINEAR) {
+            return std::min(1.0, rarityRates[RARITY_SSR] + softPityCurve.value * (step + 1));
+        }
+        return softPityCurve.rates[std::min<size_t>(step, softPityCurve.rates.size() - 1)];
+    }
+    
+    // Menghitung tabel batas rarity untuk setiap counter, sehingga pull cukup satu lookup.
+    // Baris hardPity selalu SSR (dipakai analisis; pull di hard pity tidak mengundi rarity)
+    void computeThresholds() {
+        revision++;
+        thresholds.assign(hardPity + 1, RarityThresholds());
+        double otherRates = rarityRates[RARITY_SR] + rarityRates[RARITY_R] + rarityRates[RARITY_COMMON];
+        for (int counter = 0; counter < hardPity; counter++) {
+            RarityThresholds& threshold = thresholds[counter];
+            bool soft = counter >= softPityStart;
+            if (!soft || softPityCurve.kind == SOFT_PITY_MULTIPLY) {
+                double ssrRateMultiplier = soft ? softPityCurve.value : 1.0;
+                
+                // Menentukan rarity terlebih dahulu (SSR rate dipengaruhi soft pity)
+                double adjustedSSRRate = rarityRates[RARITY_SSR] * ssrRateMultiplier;
+                double totalRate = adjustedSSRRate + otherRates;
+                
+                // Normalisasi rate untuk total 1.0
+                double normalizedSSRRate = adjustedSSRRate / totalRate;
+                double normalizedSRRate = rarityRates[RARITY_SR] / totalRate;
+                double normalizedRRate = rarityRates[RARITY_R] / totalRate;
+                
+                threshold.ssr = normalizedSSRRate;
+                threshold.sr = normalizedSSRRate + normalizedSRRate;
+                threshold.r = normalizedSSRRate + normalizedSRRate + normalizedRRate;
+            } else {
+                // Peluang SSR langsung dari kurva, rarity lain berbagi sisanya sesuai rate masing-masing
+                double ssrChance = softPityChance(counter);
+                double scale = otherRates > 0.0 ? (1.0 - ssrChance) / otherRates : 0.0;
+                threshold.ssr = ssrChance;
+                threshold.sr = ssrChance + rarityRates[RARITY_SR] * scale;
+                threshold.r = threshold.sr + rarityRates[RARITY_R] * scale;
+            }
+        }
+        thresholds[hardPity].ssr = 1.0;
+        thresholds[hardPity].sr = 1.0;
+        thresholds[hardPity].r = 1.0;
+    }
+    
+    // Indeks state rate-up dari (garansi, streak kalah, fate point)
+    uint8_t featuredStateIndex(int guaranteed, int lossStreak, int fate) const {
+        return static_cast<uint8_t>((guaranteed * (featuredRules.captureStreak + 1) + lossStreak) *
+                                    (featuredRules.fatePoints + 1) + fate);
+    }
+    
+    // Membagi SSR aktif menjadi pool featured dan standar lalu menyusun tabel state rate-up.
+    // Tanpa karakter featured aktif, banner berperilaku seperti banner biasa
+    void rebuildFeatured() {
+        featuredPool = RaritySampler();
+        standardPool = RaritySampler();
+        featuredStates.clear();
+        featuredFlags.assign(size(), 0);
+        featuredDirty = false;
+        for (uint32_t characterId : featuredIds) {
+            if (isActive(characterId)) {
+                featuredFlags[characterId] = 1;
+            }
+        }
+        
+        const RaritySampler& ssr = samplers[RARITY_SSR];
+        for (size_t i = 0; i < ssr.members.size(); i++) {
+            RaritySampler& pool = featuredFlags[ssr.members[i]] ? featuredPool : standardPool;
+            pool.members.push_back(ssr.members[i]);
+            pool.weights.push_back(ssr.weights[i]);
+        }
+        if (featuredPool.members.empty()) {
+            featuredFlags.clear();
+            return;
+        }
+        featuredPool.table.build(featuredPool.weights);
+        standardPool.table.build(standardPool.weights);
+        
+        int guarantees = featuredRules.guaranteeAfterLoss ? 2 : 1;
+        int streak = featuredRules.captureStreak;
+        int fate = featuredRules.fatePoints;
+        featuredStates.resize(static_cast<size_t>(guarantees * (streak + 1) * (fate + 1)));
+        for (int g = 0; g < guarantees; g++) {
+            for (int l = 0; l <= streak; l++) {
+                for (int f = 0; f <= fate; f++) {
+                    FeaturedState& state = featuredStates[featuredStateIndex(g, l, f)];
+                    state.guaranteed = g != 0;
+                    state.forceTarget = fate > 0 && f == fate;
+                    if (g) {
+                        state.featuredChance = 1.0;
+                    } else if (streak > 0 && l == streak) {
+                        state.featuredChance = featuredRules.captureChance;
+                    } else {
+                        state.featuredChance = featuredRules.featuredChance;
+                    }
+                    
+                    // Menang lewat garansi tidak mengubah streak kalah; menang 50/50 mereset streak
+                    int nextFate = std::min(f + 1, fate);
+                    int keptStreak = g ? l : 0;
+                    state.next[FEATURED_LOSE] = featuredStateIndex(guarantees - 1, std::min(l + 1, streak), nextFate);
+                    state.next[FEATURED_WIN] = featuredStateIndex(0, keptStreak, nextFate);
+                    state.next[FEATURED_TARGET] = featuredStateIndex(0, keptStreak, 0);
+                }
+            }
+        }
+    }
+    
+    // Memilih SSR lewat mesin rate-up dan memajukan state-nya. charRand dipakai ulang setelah diskalakan
+    // ke pool terpilih, sehingga satu pull tetap memakai tepat dua angka random
+    uint32_t pickFeatured(PityState& state, double charRand) const {
+        // State dari banner lain di jalur pity yang sama (aturan berbeda) dimulai ulang dari awal
+        if (state.featuredState >= featuredStates.size()) {
+            state.featuredState = 0;
+        }
+        const FeaturedState& current = featuredStates[state.featuredState];
+        uint32_t target = state.selectedCharPity;
+        
+        uint32_t characterId;
+        if (current.forceTarget && isFeatured(target)) {
+            characterId = target;
+        } else if (standardPool.members.empty()) {
+            characterId = featuredPool.members[featuredPool.table.sample(charRand)];
+        } else if (charRand < current.featuredChance) {
+            characterId = featuredPool.members[featuredPool.table.sample(charRand / current.featuredChance)];
+        } else {
+            double scaled = (charRand - current.featuredChance) / (1.0 - current.featuredChance);
+            characterId = standardPool.members[standardPool.table.sample(scaled)];
+        }
+        state.featuredState = current.next[featuredOutcome(characterId, target)];
+        return characterId;
+    }
+
+public:
+    // Konstruktor
+    GachaCatalog() : 
+        hardPity(90),       // Garansi pada pull ke-90
+        softPityStart(75),  // Soft pity mulai pada pull ke-75
+        softPityCurve(SoftPityCurve::multiply(5.0)), // 5x boost saat soft pity
+        dirty(false),
+        revision(0),
+        featuredDirty(false) {
+        
+        // Set rate default untuk setiap rarity
+        rarityRates[RARITY_SSR] = 0.01;  // 1%
+        rarityRates[RARITY_SR] = 0.05;   // 5%
+        rarityRates[RARITY_R] = 0.15;    // 15%
+        rarityRates[RARITY_COMMON] = 0.79; // 79%
+        
+        // Inisialisasi total rate dan batas rarity
+        recalculateTotalRates();
+        computeThresholds();
+    }
+    
+    // Recalculate total rates for each rarity (O(N), perubahan biasa sudah memperbarui total secara bertahap)
+    void recalculateTotalRates() {
+        std::fill(totalRarityRates, totalRarityRates + RARITY_COUNT, 0.0);
+        
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            for (double weight : samplers[i].weights) {
+                totalRarityRates[i] += weight;
+            }
+        }
+    }
+    
+    // Menambahkan karakter baru, mengembalikan ID-nya
+    uint32_t addCharacter(const std::string& name, Rarity rarity, double rate, 
+                    const std::string& title = "", const std::string& element = "") {
+        Character character;
+        character.name = name;
+        character.rarity = rarity;
+        character.rate = rate;
+        character.title = title;
+        character.element = element;
+        
+        return insertCharacter(std::move(character));
+    }
+    
+    // Menambahkan karakter yang sudah lengkap (dipindahkan, bukan disalin), mengembalikan ID-nya
+    uint32_t addCharacter(Character character) {
+        return insertCharacter(std::move(character));
+    }
+    
+    // Menyiapkan kapasitas untuk count karakter tambahan
+    void reserve(size_t count) {
+        size_t total = size() + count;
+        characterRarities.reserve(total);
+        characterRates.reserve(total);
+        characterNames.reserve(total);
+        characterInfos.reserve(total);
+        memberPositions.reserve(total);
+    }
+    
+    // Pemuat katalog massal: O(1) per karakter, sampler dibangun sekali saat compile()
+    void addCharacters(const std::vector<Character>& newCharacters) {
+        reserve(newCharacters.size());
+        for (const auto& character : newCharacters) {
+            insertCharacter(character);
+        }
+    }
+    
+    // Seperti addCharacters() di atas, tetapi memindahkan karakter (string tidak disalin)
+    void addCharacters(std::vector<Character>&& newCharacters) {
+        reserve(newCharacters.size());
+        for (auto& character : newCharacters) {
+            insertCharacter(std::move(character));
+        }
+        newCharacters.clear();
+    }
+    
+    // Menghapus karakter dari banner. ID-nya tetap dipakai (riwayat lama tetap bisa dibaca),
+    // karakter hanya tidak bisa didapat lagi. False jika ID tidak valid atau sudah dihapus
+    bool removeCharacter(uint32_t characterId) {
+        if (!isActive(characterId)) {
+            return false;
+        }
+        Rarity rarity = characterRarities[characterId];
+        RaritySampler& sampler = samplers[rarity];
+        
+        // Tukar dengan anggota terakhir lalu buang, O(1)
+        uint32_t position = memberPositions[characterId];
+        uint32_t moved = sampler.members.back();
+        sampler.members[position] = moved;
+        sampler.weights[position] = sampler.weights.back();
+        memberPositions[moved] = position;
+        sampler.members.pop_back();
+        sampler.weights.pop_back();
+        memberPositions[characterId] = REMOVED_POSITION;
+        
+        totalRarityRates[rarity] -= characterRates[characterId];
+        markDirty(rarity);
+        return true;
+    }
+    
+    // Mengubah rate satu karakter aktif, false jika ID tidak valid atau rate negatif
+    bool setCharacterRate(uint32_t characterId, double rate) {
+        if (!isActive(characterId) || !(rate >= 0.0)) {
+            return false;
+        }
+        Rarity rarity = characterRarities[characterId];
+        totalRarityRates[rarity] += rate - characterRates[characterId];
+        characterRates[characterId] = rate;
+        samplers[rarity].weights[memberPositions[characterId]] = rate;
+        markDirty(rarity);
+        return true;
+    }
+    
+    // Mengatur karakter featured (SSR) dan aturan rate-up banner; daftar kosong = banner tanpa rate-up.
+    // False (tanpa perubahan) jika ada ID yang bukan SSR atau aturannya di luar batas
+    bool setFeatured(const std::vector<uint32_t>& characterIds, const FeaturedRules& rules) {
+        if (!(rules.featuredChance >= 0.0 && rules.featuredChance <= 1.0) ||
+            !(rules.captureChance >= 0.0 && rules.captureChance <= 1.0) ||
+            rules.captureStreak < 0 || rules.captureStreak > MAX_FEATURED_STREAK ||
+            rules.fatePoints < 0 || rules.fatePoints > MAX_FEATURED_STREAK) {
+            return false;
+        }
+        for (uint32_t characterId : characterIds) {
+            if (characterId >= size() || characterRarities[characterId] != RARITY_SSR) {
+                return false;
+            }
+        }
+        featuredIds = characterIds;
+        featuredRules = rules;
+        featuredDirty = true;
+        dirty = true;
+        revision++;
+        return true;
+    }
+    
+    // Membangun ulang tabel alias rarity yang berubah (O(jumlah anggota rarity tersebut))
+    void compile() {
+        if (!dirty) {
+            return;
+        }
+        bool ssrChanged = samplers[RARITY_SSR].dirty;
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            if (samplers[i].dirty) {
+                rebuildSampler(static_cast<Rarity>(i));
+            }
+        }
+        if (ssrChanged || featuredDirty) {
+            rebuildFeatured();
+        }
+        dirty = false;
+    }
+    
+    // True jika ada perubahan yang belum dikompilasi
+    bool needsCompile() const {
+        return dirty;
+    }
+    
+    // Nomor perubahan katalog ini; nilai yang sama berarti sidiknya belum berubah
+    uint64_t getRevision() const {
+        return revision;
+    }
+    
+    // Sidik 16-bit isi katalog yang menentukan hasil pull (pengaturan, rate, karakter dan urutan anggota
+    // sampler), dicatat sebagai versi banner di catatan pull. Katalog harus sudah dikompilasi
+    uint16_t fingerprint() const {
+        SnapshotWriter writer;
+        writeTo(writer);
+        
+        // FNV-1a 32-bit, dilipat menjadi 16-bit
+        uint32_t hash = 2166136261u;
+        auto mix = [&hash](const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ bytes[i]) * 16777619u;
+            }
+        };
+        mix(writer.bytes(), writer.length());
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            mix(samplers[i].members.data(), samplers[i].members.size() * sizeof(uint32_t));
+        }
+        return static_cast<uint16_t>(hash ^ (hash >> 16));
+    }
+    
+    // True jika ID ada dan karakternya belum dihapus
+    bool isActive(uint32_t characterId) const {
+        return characterId < size() && memberPositions[characterId] != REMOVED_POSITION;
+    }
+    
+    // Menambahkan karakter baru dengan nama rarity, false jika rarity tidak dikenal
+    bool addCharacter(const std::string& name, const std::string& rarity, double rate, 
+                    const std::string& title = "", const std::string& element = "") {
+        Rarity rarityId;
+        if (!parseRarity(rarity, rarityId)) {
+            return false;
+        }
+        addCharacter(name, rarityId, rate, title, element);
+        return true;
+    }
+    
+    // Mengatur parameter pity, false (tanpa perubahan) jika tidak valid
+    bool setPitySettings(int hardPityValue, int softPityValue, double softPityBoostValue) {
+        return setPitySettings(hardPityValue, softPityValue, SoftPityCurve::multiply(softPityBoostValue));
+    }
+    
+    // Mengatur pity dengan kurva soft pity sembarang; tabel batas per counter dihitung sekali di sini
+    bool setPitySettings(int hardPityValue, int softPityValue, const SoftPityCurve& curve) {
+        if (hardPityValue > 0 && hardPityValue <= MAX_HARD_PITY && softPityValue > 0 && softPityValue < hardPityValue && curve.valid()) {
+            hardPity = hardPityValue;
+            softPityStart = softPityValue;
+            softPityCurve = curve;
+            computeThresholds();
+            return true;
+        }
+        return false;
+    }
+    
+    // Mengatur rate setiap rarity, false (tanpa perubahan) jika ada yang negatif atau jumlahnya bukan 1
+    bool setRarityRates(const double rates[RARITY_COUNT]) {
+        double total = 0.0;
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            if (!(rates[i] >= 0.0 && rates[i] <= 1.0)) {
+                return false;
+            }
+            total += rates[i];
+        }
+        if (std::fabs(total - 1.0) > RATE_SUM_TOLERANCE) {
+            return false;
+        }
+        std::copy(rates, rates + RARITY_COUNT, rarityRates);
+        computeThresholds();
+        return true;
+    }
+    
+    // Inti satu pull: hanya mengubah state pity, selalu memakai tepat dua angka random.
+    // Aman dipanggil dari banyak thread (dipakai juga oleh simulasi dan server)
+    GachaResult resolvePull(PityState& state, double rarityRand, double charRand) const {
+        state.pullCount++;
+        GachaResult result;
+        
+        // Periksa apakah ini adalah hard pity
+        if (state.pullCount >= hardPity) {
+            // Banner rate-up memakai mesin state-nya juga saat hard pity; karakter pity yang sudah
+            // dihapus diganti undian SSR biasa dari charRand
+            if (!featuredStates.empty() || !isActive(state.selectedCharPity)) {
+                result = finishPull(state, RARITY_SSR, charRand);
+                result.isPity = true;
+                return result;
+            }
+            result.characterId = state.selectedCharPity;
+            result.rarity = RARITY_SSR;
+            result.isPity = true;
+            result.bannerId = 0;
+            result.pullNumber = state.pullCount;
+            state.pullCount = 0; // Reset counter setelah mendapat garansi
+            return result;
+        }
+        
+        // Batas rarity counter ini (termasuk soft pity) diambil langsung dari tabel
+        return finishPull(state, classifyRarity(rarityRand, thresholds[state.pullCount]), charRand);
+    }
+    
+    // Menyelesaikan pull non-pity yang rarity-nya sudah ditentukan (counter sudah ditambah)
+    GachaResult finishPull(PityState& state, Rarity selectedRarity, double charRand) const {
+        GachaResult result;
+        
+        // Pilih karakter spesifik dari rarity terpilih lewat tabel alias
+        const RaritySampler& sampler = samplers[selectedRarity];
+        
+        result.rarity = selectedRarity;
+        result.isPity = false;
+        result.bannerId = 0;
+        result.pullNumber = state.pullCount;
+        
+        // Default jika tidak ada karakter untuk rarity tersebut
+        if (sampler.table.empty()) {
+            result.characterId = NO_CHARACTER;
+        } else if (selectedRarity == RARITY_SSR && !featuredStates.empty()) {
+            result.characterId = pickFeatured(state, charRand);
+        } else {
+            result.characterId = sampler.members[sampler.table.sample(charRand)];
+        }
+        
+        // Reset counter jika mendapat SSR
+        if (selectedRarity == RARITY_SSR) {
+            state.pullCount = 0;
+        }
+        return result;
+    }
+    
+    // Menyelesaikan count pull dari angka random berpasangan (rarity, karakter) ke out.
+    // Hasilnya sama persis dengan memanggil resolvePull() satu per satu
+    void resolveBatch(PityState& state, const double* uniforms, size_t count, GachaResult* out) const {
+        double rarityRands[SPECULATION_WINDOW];
+        uint8_t rarities[SPECULATION_WINDOW];
+        
+        // Rarity diklasifikasi per jendela dengan SIMD; jika counter reset (SSR atau hard pity),
+        // sisa jendela diklasifikasi ulang dari counter yang baru
+        size_t i = 0;
+        while (i < count) {
+            size_t windowStart = i;
+            size_t windowSize = std::min(SPECULATION_WINDOW, count - i);
+            for (size_t j = 0; j < windowSize; j++) {
+                rarityRands[j] = uniforms[2 * (windowStart + j)];
+            }
+            classifyRarityBlock(rarityRands, windowSize, state.pullCount, softPityStart, thresholds.data(),
+                                thresholds.size(), rarities);
+            
+            while (i < windowStart + windowSize) {
+                double charRand = uniforms[2 * i + 1];
+                if (state.pullCount + 1 >= hardPity) {
+                    out[i] = resolvePull(state, uniforms[2 * i], charRand);
+                } else {
+                    state.pullCount++;
+                    out[i] = finishPull(state, static_cast<Rarity>(rarities[i - windowStart]), charRand);
+                }
+                i++;
+                if (state.pullCount == 0) {
+                    break;
+                }
+            }
+        }
+    }
+    
+    // True jika karakter termasuk featured aktif (setelah compile())
+    bool isFeatured(uint32_t characterId) const {
+        return characterId < featuredFlags.size() && featuredFlags[characterId];
+    }
+    
+    // Jenis hasil SSR characterId di mesin rate-up bagi pemain dengan karakter pilihan target
+    FeaturedOutcome featuredOutcome(uint32_t characterId, uint32_t target) const {
+        if (!isFeatured(characterId)) {
+            return FEATURED_LOSE;
+        }
+        return characterId == target ? FEATURED_TARGET : FEATURED_WIN;
+    }
+    
+    // State rate-up setelah SSR characterId didapat (dipakai saat memutar ulang catatan pull).
+    // State tidak berubah di banner tanpa rate-up
+    uint8_t nextFeaturedState(uint8_t featuredState, uint32_t characterId, uint32_t target) const {
+        if (featuredStates.empty()) {
+            return featuredState;
+        }
+        if (featuredState >= featuredStates.size()) {
+            featuredState = 0;
+        }
+        return featuredStates[featuredState].next[featuredOutcome(characterId, target)];
+    }
+    
+    // True jika banner punya rate-up aktif (setelah compile())
+    bool hasFeatured() const {
+        return !featuredStates.empty();
+    }
+    
+    // Tabel state rate-up yang sama dengan yang dipakai pull (untuk analisis dan simulasi)
+    const std::vector<FeaturedState>& getFeaturedStates() const {
+        return featuredStates;
+    }
+    
+    // Pool SSR featured dan standar hasil compile()
+    const RaritySampler& getFeaturedPool() const {
+        return featuredPool;
+    }
+    
+    const RaritySampler& getStandardPool() const {
+        return standardPool;
+    }
+    
+    const std::vector<uint32_t>& getFeaturedIds() const {
+        return featuredIds;
+    }
+    
+    const FeaturedRules& getFeaturedRules() const {
+        return featuredRules;
+    }
+    
+    // Mendapatkan parameter pity
+    int getHardPity() const {
+        return hardPity;
+    }
+    
+    int getSoftPityStart() const {
+        return softPityStart;
+    }
+    
+    // Faktor kurva MULTIPLY (1 untuk kurva lain)
+    double getSoftPityBoost() const {
+        return softPityCurve.kind == SOFT_PITY_MULTIPLY ? softPityCurve.value : 1.0;
+    }
+    
+    const SoftPityCurve& getSoftPityCurve() const {
+        return softPityCurve;
+    }
+    
+    // Batas rarity pull dengan nilai counter tertentu (setelah ditambah 1); counter >= hardPity selalu SSR
+    const RarityThresholds& getThresholdsAt(int counter) const {
+        return thresholds[std::min(std::max(counter, 0), hardPity)];
+    }
+    
+    // Jumlah karakter di katalog (termasuk yang sudah dihapus)
+    size_t size() const {
+        return characterRarities.size();
+    }
+    
+    // Kolom karakter berdasarkan ID (pemanggil memastikan ID < size())
+    Rarity getRarity(uint32_t characterId) const {
+        return characterRarities[characterId];
+    }
+    
+    double getRate(uint32_t characterId) const {
+        return characterRates[characterId];
+    }
+    
+    const std::string& getName(uint32_t characterId) const {
+        return characterNames[characterId];
+    }
+    
+    const std::string& getTitle(uint32_t characterId) const {
+        return characterInfos[characterId].title;
+    }
+    
+    const std::string& getElement(uint32_t characterId) const {
+        return characterInfos[characterId].element;
+    }
+    
+    // Salinan lengkap satu karakter (mis. untuk dipindah ke katalog lain)
+    Character getCharacter(uint32_t characterId) const {
+        Character character;
+        character.name = characterNames[characterId];
+        character.rarity = characterRarities[characterId];
+        character.rate = characterRates[characterId];
+        character.title = characterInfos[characterId].title;
+        character.element = characterInfos[characterId].element;
+        return character;
+    }
+    
+    // Mencari indeks karakter SSR aktif berdasarkan nama (ID terkecil jika ada nama ganda), -1 jika tidak ada.
+    // Hanya partisi SSR yang dipindai
+    int findSSRCharacter(const std::string& name) const {
+        int found = -1;
+        for (uint32_t characterId : samplers[RARITY_SSR].members) {
+            if (characterNames[characterId] == name && (found < 0 || characterId < static_cast<uint32_t>(found))) {
+                found = static_cast<int>(characterId);
+            }
+        }
+        return found;
+    }
+    
+    // Mendapatkan nama item dari hasil pull
+    std::string getItemName(const GachaResult& result) const {
+        if (result.characterId < size()) {
+            return characterNames[result.characterId];
+        }
+        return std::string(rarityName(result.rarity)) + " Item";
+    }
+    
+    // ID karakter aktif satu rarity, tanpa salinan. Urutannya urutan tambah, kecuali posisi karakter
+    // yang dihapus diisi anggota terakhir. View berlaku sampai katalog diubah
+    std::span<const uint32_t> getCharactersByRarity(Rarity rarity) const {
+        return samplers[rarity].members;
+    }
+    
+    // Rate karakter aktif satu rarity, sejajar dengan getCharactersByRarity()
+    std::span<const double> getRatesByRarity(Rarity rarity) const {
+        return samplers[rarity].weights;
+    }
+    
+    // Mendapatkan rate berdasarkan rarity
+    double getRarityRate(Rarity rarity) const {
+        if (rarity < RARITY_COUNT) {
+            return rarityRates[rarity];
+        }
+        return 0.0;
+    }
+    
+    // Total rate karakter aktif dalam satu rarity (cache, O(1))
+    double getCharacterRateTotal(Rarity rarity) const {
+        if (rarity < RARITY_COUNT) {
+            return totalRarityRates[rarity];
+        }
+        return 0.0;
+    }
+    
+    // Menulis katalog sebagai satu section snapshot
+    void writeTo(SnapshotWriter& writer) const {
+        writer.beginSection(SECTION_CATALOG);
+        writer.put<int32_t>(hardPity);
+        writer.put<int32_t>(softPityStart);
+        writer.put<double>(softPityCurve.value);
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            writer.put<double>(rarityRates[i]);
+        }
+        writer.put<uint64_t>(size());
+        for (size_t i = 0; i < size(); i++) {
+            writer.put<uint8_t>(characterRarities[i]);
+            writer.put<uint8_t>(isActive(static_cast<uint32_t>(i)) ? 0 : CHARACTER_REMOVED_FLAG);
+            writer.put<double>(characterRates[i]);
+            writer.putString(characterNames[i]);
+            writer.putString(characterInfos[i].title);
+            writer.putString(characterInfos[i].element);
+        }
+        
+        // Aturan rate-up (versi 4 ke atas)
+        writer.put<uint32_t>(static_cast<uint32_t>(featuredIds.size()));
+        writer.putArray(featuredIds.data(), featuredIds.size());
+        writer.put<double>(featuredRules.featuredChance);
+        writer.put<uint8_t>(featuredRules.guaranteeAfterLoss ? 1 : 0);
+        writer.put<uint8_t>(static_cast<uint8_t>(featuredRules.captureStreak));
+        writer.put<double>(featuredRules.captureChance);
+        writer.put<uint8_t>(static_cast<uint8_t>(featuredRules.fatePoints));
+        
+        // Bentuk kurva soft pity (versi 5 ke atas; nilainya sudah ditulis di depan)
+        writer.put<uint8_t>(softPityCurve.kind);
+        writer.put<uint32_t>(static_cast<uint32_t>(softPityCurve.rates.size()));
+        writer.putArray(softPityCurve.rates.data(), softPityCurve.rates.size());
+        writer.endSection();
+    }
+    
+    // Memuat katalog dari section snapshot, false (tanpa perubahan) jika isinya tidak valid.
+    // Katalog yang dimuat sudah dikompilasi
+    bool readFrom(SnapshotReader& reader) {
+        int32_t hardPityValue = reader.get<int32_t>();
+        int32_t softPityValue = reader.get<int32_t>();
+        SoftPityCurve curve = SoftPityCurve::multiply(reader.get<double>());
+        double rates[RARITY_COUNT];
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            rates[i] = reader.get<double>();
+        }
+        uint64_t count = reader.get<uint64_t>();
+        if (!reader.ok() || hardPityValue <= 0 || hardPityValue > MAX_HARD_PITY || softPityValue <= 0 ||
+            softPityValue >= hardPityValue) {
+            return false;
+        }
+        
+        std::vector<Character> loaded;
+        std::vector<uint32_t> removed;
+        for (uint64_t i = 0; i < count && reader.ok(); i++) {
+            Character character;
+            uint8_t rarity = reader.get<uint8_t>();
+            character.rarity = static_cast<Rarity>(rarity);
+            
+            // Versi 1 belum punya flag karakter
+            uint8_t flags = reader.getVersion() >= 2 ? reader.get<uint8_t>() : 0;
+            if (flags & CHARACTER_REMOVED_FLAG) {
+                removed.push_back(static_cast<uint32_t>(i));
+            }
+            character.rate = reader.get<double>();
+            character.name = reader.getString();
+            character.title = reader.getString();
+            character.element = reader.getString();
+            if (rarity >= RARITY_COUNT) {
+                return false;
+            }
+            loaded.push_back(character);
+        }
+        
+        // Versi 1-3 belum punya rate-up
+        std::vector<uint32_t> featured;
+        FeaturedRules rules;
+        if (reader.getVersion() >= 4 && reader.ok()) {
+            uint32_t featuredCount = reader.get<uint32_t>();
+            const uint32_t* ids = reader.getArray<uint32_t>(featuredCount);
+            if (ids) {
+                featured.assign(ids, ids + featuredCount);
+            }
+            rules.featuredChance = reader.get<double>();
+            rules.guaranteeAfterLoss = reader.get<uint8_t>() != 0;
+            rules.captureStreak = reader.get<uint8_t>();
+            rules.captureChance = reader.get<double>();
+            rules.fatePoints = reader.get<uint8_t>();
+        }
+        
+        // Versi 1-4 hanya punya kurva MULTIPLY
+        if (reader.getVersion() >= 5 && reader.ok()) {
+            curve.kind = static_cast<SoftPityKind>(reader.get<uint8_t>());
+            uint32_t rateCount = reader.get<uint32_t>();
+            const double* storedRates = reader.getArray<double>(rateCount);
+            if (storedRates) {
+                curve.rates.assign(storedRates, storedRates + rateCount);
+            }
+        }
+        if (!reader.ok() || curve.kind > SOFT_PITY_TABLE || !curve.valid()) {
+            return false;
+        }
+        
+        GachaCatalog catalog;
+        catalog.hardPity = hardPityValue;
+        catalog.softPityStart = softPityValue;
+        catalog.softPityCurve = curve;
+        std::copy(rates, rates + RARITY_COUNT, catalog.rarityRates);
+        catalog.addCharacters(std::move(loaded));
+        for (uint32_t characterId : removed) {
+            catalog.removeCharacter(characterId);
+        }
+        if (!catalog.setFeatured(featured, rules)) {
+            return false;
+        }
+        catalog.computeThresholds();
+        catalog.compile();
+        *this = std::move(catalog);
+        return true;
+    }
+};
+
+// Kolom state pity pemain di section SECTION_PLAYERS (pointer langsung ke file yang dipetakan).
+// Setiap pemain punya satu counter dan satu state rate-up per jalur pity, dan satu karakter pity per banner
+struct PlayerColumns {
+    // Batas jalur pity dan banner (ID banner disimpan 8-bit di hasil pull dan catatan)
+    static constexpr uint32_t MAX_COLUMNS = 256;
+    
+    uint64_t count;
+    uint64_t seed;                      // Seed stream random pemain
+    uint32_t trackCount;
+    uint32_t bannerCount;
+    const int32_t* pullCounts;          // [pemain * trackCount + jalur]
+    const uint32_t* selectedCharPity;   // [pemain * bannerCount + banner]
+    const uint64_t* pullIndices;        // Jumlah pull yang sudah dilakukan tiap pemain
+    const uint8_t* featuredStates;      // [pemain * trackCount + jalur], nullptr = semua 0 (snapshot versi 1-3)
+    
+    PlayerColumns() :
+        count(0), seed(0), trackCount(1), bannerCount(1),
+        pullCounts(nullptr), selectedCharPity(nullptr), pullIndices(nullptr), featuredStates(nullptr) {}
+    
+    // State rate-up satu pemain di satu jalur
+    uint8_t featuredStateOf(uint64_t player, uint32_t track) const {
+        return featuredStates ? featuredStates[player * trackCount + track] : 0;
+    }
+    
+    void writeTo(SnapshotWriter& writer) const {
+        writer.beginSection(SECTION_PLAYERS);
+        writer.put<uint64_t>(count);
+        writer.put<uint64_t>(seed);
+        writer.put<uint32_t>(trackCount);
+        writer.put<uint32_t>(bannerCount);
+        writer.putArray(pullCounts, count * trackCount);
+        writer.putArray(selectedCharPity, count * bannerCount);
+        writer.putArray(pullIndices, count);
+        writer.putArray(featuredStates, count * trackCount);
+        writer.endSection();
+    }
+    
+    // Membaca kolom tanpa memeriksa isinya; false jika section terpotong
+    bool readFrom(SnapshotReader& reader) {
+        count = reader.get<uint64_t>();
+        seed = reader.get<uint64_t>();
+        
+        // Versi 1-2 hanya punya satu banner dengan satu jalur pity
+        trackCount = reader.getVersion() >= 3 ? reader.get<uint32_t>() : 1;
+        bannerCount = reader.getVersion() >= 3 ? reader.get<uint32_t>() : 1;
+        if (!reader.ok() || trackCount == 0 || trackCount > MAX_COLUMNS || bannerCount == 0 ||
+            bannerCount > MAX_COLUMNS || count > SIZE_MAX / MAX_COLUMNS) {
+            return false;
+        }
+        pullCounts = reader.getArray<int32_t>(static_cast<size_t>(count * trackCount));
+        selectedCharPity = reader.getArray<uint32_t>(static_cast<size_t>(count * bannerCount));
+        pullIndices = reader.getArray<uint64_t>(static_cast<size_t>(count));
+        featuredStates = reader.getVersion() >= 4 ? reader.getArray<uint8_t>(static_cast<size_t>(count * trackCount)) : nullptr;
+        return reader.ok();
+    }
+    
+    // Membaca kolom pemain satu banner, false jika ada state yang tidak cocok dengan katalog
+    bool readFrom(SnapshotReader& reader, const GachaCatalog& catalog) {
+        if (!readFrom(reader) || trackCount != 1 || bannerCount != 1) {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; i++) {
+            if (pullCounts[i] < 0 || pullCounts[i] >= catalog.getHardPity() ||
+                (selectedCharPity[i] != 0 && selectedCharPity[i] >= catalog.size())) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // GACHA_CATALOG_H
@@ -0,0 +1,162 @@
+#include "gacha_metrics.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Semua shard yang pernah dibuat; tidak pernah dihapus agar hitungan thread yang selesai tetap ada
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<std::unique_ptr<GachaMetrics::Shard>>& registry() {
+    static std::vector<std::unique_ptr<GachaMetrics::Shard>> shards;
+    return shards;
+}
+
+const char* const HISTOGRAM_OPERATIONS[HISTOGRAM_COUNT] = { "pull", "multi_pull", "server_pull", "server_batch" };
+
+// Batas bucket yang diekspor: pangkat dua dari 16 ns sampai sekitar 17 detik
+const int EXPORT_MIN_EXPONENT = 4;
+const int EXPORT_MAX_EXPONENT = 34;
+
+void writeCounter(std::ostream& out, const char* name, const char* help, uint64_t value) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " counter\n";
+    out << name << " " << value << "\n";
+}
+
+}  // namespace
+
+GachaMetrics::Shard::Shard() {
+    for (auto& counter : counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (auto& histogram : buckets) {
+        for (auto& bucket : histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (int i = 0; i < HISTOGRAM_COUNT; i++) {
+        counts[i].store(0, std::memory_order_relaxed);
+        sums[i].store(0, std::memory_order_relaxed);
+        sampleCountdown[i] = 1;
+    }
+}
+
+std::atomic<bool>& GachaMetrics::enabledFlag() {
+    static std::atomic<bool> flag(true);
+    return flag;
+}
+
+void GachaMetrics::setEnabled(bool value) {
+    enabledFlag().store(value, std::memory_order_relaxed);
+}
+
+std::atomic<uint32_t>& GachaMetrics::samplingInterval() {
+    static std::atomic<uint32_t> interval(32);
+    return interval;
+}
+
+void GachaMetrics::setLatencySampling(uint32_t interval) {
+    samplingInterval().store(interval > 0 ? interval : 1, std::memory_order_relaxed);
+}
+
+GachaMetrics::Shard& GachaMetrics::registerShard() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(std::unique_ptr<Shard>(new Shard()));
+    return *registry().back();
+}
+
+MetricsSnapshot GachaMetrics::snapshot() {
+    MetricsSnapshot result;
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const auto& shard : registry()) {
+        for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+            result.counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+        }
+        for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+            LatencyHistogram& histogram = result.histograms[h];
+            for (int b = 0; b < LatencyHistogram::BUCKET_COUNT; b++) {
+                histogram.buckets[b] += shard->buckets[h][b].load(std::memory_order_relaxed);
+            }
+            histogram.count += shard->counts[h].load(std::memory_order_relaxed);
+            histogram.sum += shard->sums[h].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+// Catatan: tambahan yang sedang ditulis thread lain bersamaan dengan reset bisa hilang
+void GachaMetrics::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const auto& shard : registry()) {
+        for (auto& counter : shard->counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+            for (auto& bucket : shard->buckets[h]) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            shard->counts[h].store(0, std::memory_order_relaxed);
+            shard->sums[h].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void GachaMetrics::writePrometheus(std::ostream& out) {
+    MetricsSnapshot metrics = snapshot();
+    
+    writeCounter(out, "gacha_pulls_total", "Jumlah pull yang diselesaikan.", metrics.counters[METRIC_PULLS]);
+    
+    out << "# HELP gacha_pulls_by_rarity_total Jumlah hasil pull per rarity.\n";
+    out << "# TYPE gacha_pulls_by_rarity_total counter\n";
+    for (int i = 0; i < RARITY_COUNT; i++) {
+        out << "gacha_pulls_by_rarity_total{rarity=\"" << rarityName(static_cast<Rarity>(i)) << "\"} "
+            << metrics.counters[METRIC_PULLS_SSR + i] << "\n";
+    }
+    
+    writeCounter(out, "gacha_hard_pity_total", "Pull yang memicu hard pity.", metrics.counters[METRIC_HARD_PITY]);
+    writeCounter(out, "gacha_soft_pity_pulls_total", "Pull yang terjadi saat soft pity.",
+                 metrics.counters[METRIC_SOFT_PITY_PULLS]);
+    writeCounter(out, "gacha_soft_pity_ssr_total", "SSR yang didapat saat soft pity sebelum hard pity.",
+                 metrics.counters[METRIC_SOFT_PITY_SSR]);
+    writeCounter(out, "gacha_multi_pull_calls_total", "Jumlah panggilan multiPull().",
+                 metrics.counters[METRIC_MULTI_PULL_CALLS]);
+    writeCounter(out, "gacha_server_batches_total", "Jumlah batch permintaan pull yang dijalankan server.",
+                 metrics.counters[METRIC_SERVER_BATCHES]);
+    
+    out << "# HELP gacha_pull_latency_seconds Latensi operasi pull (tersampel, lihat setLatencySampling).\n";
+    out << "# TYPE gacha_pull_latency_seconds histogram\n";
+    for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+        const LatencyHistogram& histogram = metrics.histograms[h];
+        const char* operation = HISTOGRAM_OPERATIONS[h];
+        
+        // Bucket halus digabung per pangkat dua; bucket di bawah indeks exponent * SUB_BUCKETS < 2^exponent ns
+        uint64_t cumulative = 0;
+        int next = 0;
+        for (int exponent = EXPORT_MIN_EXPONENT; exponent <= EXPORT_MAX_EXPONENT; exponent++) {
+            for (; next < exponent * LatencyHistogram::SUB_BUCKETS; next++) {
+                cumulative += histogram.buckets[next];
+            }
+            out << "gacha_pull_latency_seconds_bucket{op=\"" << operation << "\",le=\""
+                << static_cast<double>(uint64_t(1) << exponent) * 1e-9 << "\"} " << cumulative << "\n";
+        }
+        out << "gacha_pull_latency_seconds_bucket{op=\"" << operation << "\",le=\"+Inf\"} " << histogram.count << "\n";
+        out << "gacha_pull_latency_seconds_sum{op=\"" << operation << "\"} " << histogram.sum * 1e-9 << "\n";
+        out << "gacha_pull_latency_seconds_count{op=\"" << operation << "\"} " << histogram.count << "\n";
+    }
+}
+
+bool GachaMetrics::writePrometheusFile(const std::string& path) {
+    std::ofstream out(path.c_str());
+    if (!out) {
+        return false;
+    }
+    writePrometheus(out);
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,273 @@
+#ifndef GACHA_METRICS_H
+#define GACHA_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "gacha_types.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Counter yang dicatat di jalur pull
+enum MetricCounter {
+    METRIC_PULLS,               // Total pull yang diselesaikan
+    METRIC_PULLS_SSR,           // Hasil per rarity (urutan sama dengan Rarity)
+    METRIC_PULLS_SR,
+    METRIC_PULLS_R,
+    METRIC_PULLS_COMMON,
+    METRIC_HARD_PITY,           // Pull yang memicu hard pity
+    METRIC_SOFT_PITY_PULLS,     // Pull non-pity yang terjadi saat soft pity
+    METRIC_SOFT_PITY_SSR,       // SSR yang didapat saat soft pity (tanpa hard pity)
+    METRIC_MULTI_PULL_CALLS,    // Panggilan multiPull()
+    METRIC_SERVER_BATCHES,      // Batch yang dijalankan GachaServer::pullBatch()
+    METRIC_COUNTER_COUNT
+};
+
+// Histogram latensi (nanodetik)
+enum MetricHistogram {
+    HISTOGRAM_PULL,             // GachaSystem::pull()
+    HISTOGRAM_MULTI_PULL,       // GachaSystem::multiPull()
+    HISTOGRAM_SERVER_PULL,      // GachaServer::pull()
+    HISTOGRAM_SERVER_BATCH,     // GachaServer::pullBatch()
+    HISTOGRAM_COUNT
+};
+
+// Histogram latensi dengan bucket log gaya HDR: 4 sub-bucket per pangkat dua
+// (galat relatif maksimal 25%), cukup untuk nilai 1 ns sampai 2^64 ns
+struct LatencyHistogram {
+    static constexpr int SUB_BUCKET_BITS = 2;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKET_COUNT = 64 * SUB_BUCKETS;
+    
+    uint64_t buckets[BUCKET_COUNT];
+    uint64_t count;
+    uint64_t sum;
+    
+    LatencyHistogram() : count(0), sum(0) {
+        for (uint64_t& bucket : buckets) {
+            bucket = 0;
+        }
+    }
+    
+    // Posisi bit tertinggi (value > 0)
+    static int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        int exponent = 63;
+        while (!(value >> exponent)) {
+            exponent--;
+        }
+        return exponent;
+#endif
+    }
+    
+    // Indeks bucket untuk sebuah nilai (nilai < SUB_BUCKETS masuk bucket-nya sendiri)
+    static int bucketFor(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<int>(value);
+        }
+        int exponent = highestBit(value);
+        int sub = static_cast<int>((value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        return exponent * SUB_BUCKETS + sub;
+    }
+    
+    // Batas atas (eksklusif) bucket ke-index
+    static uint64_t bucketUpperBound(int index) {
+        if (index < SUB_BUCKETS) {
+            return static_cast<uint64_t>(index) + 1;
+        }
+        int exponent = index / SUB_BUCKETS;
+        uint64_t sub = static_cast<uint64_t>(index % SUB_BUCKETS);
+        if (exponent == 63 && sub == SUB_BUCKETS - 1) {
+            return UINT64_MAX;
+        }
+        return (SUB_BUCKETS + sub + 1) << (exponent - SUB_BUCKET_BITS);
+    }
+    
+    // Nilai terkecil yang mencakup fraksi p (0..1) dari sampel, dibulatkan ke batas bucket
+    uint64_t percentile(double p) const {
+        uint64_t cumulative = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            cumulative += buckets[i];
+            if (count > 0 && cumulative >= p * count) {
+                return bucketUpperBound(i) - 1;
+            }
+        }
+        return 0;
+    }
+    
+    double mean() const {
+        return count > 0 ? static_cast<double>(sum) / count : 0.0;
+    }
+};
+
+// Hasil gabungan semua thread pada satu saat
+struct MetricsSnapshot {
+    uint64_t counters[METRIC_COUNTER_COUNT];
+    LatencyHistogram histograms[HISTOGRAM_COUNT];
+    
+    MetricsSnapshot() {
+        for (uint64_t& counter : counters) {
+            counter = 0;
+        }
+    }
+};
+
+// Metrik jalur pull. Setiap thread menulis ke shard miliknya sendiri (tanpa lock dan tanpa
+// operasi atomik read-modify-write); shard digabung saat dibaca. Jika GACHA_ENABLE_METRICS
+// tidak didefinisikan, enabled() bernilai konstan false dan semua pencatatan hilang saat kompilasi
+class GachaMetrics {
+public:
+    // Penyimpanan milik satu thread (hanya thread itu yang menulis)
+    struct Shard {
+        std::atomic<uint64_t> counters[METRIC_COUNTER_COUNT];
+        std::atomic<uint64_t> buckets[HISTOGRAM_COUNT][LatencyHistogram::BUCKET_COUNT];
+        std::atomic<uint64_t> counts[HISTOGRAM_COUNT];
+        std::atomic<uint64_t> sums[HISTOGRAM_COUNT];
+        uint32_t sampleCountdown[HISTOGRAM_COUNT];   // Sisa panggilan sampai sampel latensi berikutnya
+        
+        Shard();
+    };
+
+#ifdef GACHA_ENABLE_METRICS
+    static bool enabled() {
+        return enabledFlag().load(std::memory_order_relaxed);
+    }
+#else
+    static constexpr bool enabled() {
+        return false;
+    }
+#endif
+
+    // Menyalakan atau mematikan pencatatan saat runtime (tidak berpengaruh jika dikompilasi tanpa metrik)
+    static void setEnabled(bool value);
+    
+    // Latensi diukur pada 1 dari setiap interval panggilan per thread (default 32, 1 = semua).
+    // Membaca jam dua kali lebih mahal dari satu pull, jadi pull tunggal sebaiknya disampel
+    static void setLatencySampling(uint32_t interval);
+    
+    // True jika panggilan ini perlu diukur latensinya
+    static bool sampleLatency(MetricHistogram histogram) {
+        if (!enabled()) {
+            return false;
+        }
+        uint32_t& countdown = localShard().sampleCountdown[histogram];
+        if (countdown > 1) {
+            countdown--;
+            return false;
+        }
+        countdown = samplingInterval().load(std::memory_order_relaxed);
+        return true;
+    }
+    
+    static void add(MetricCounter counter, uint64_t amount = 1) {
+        if (enabled()) {
+            increment(localShard().counters[counter], amount);
+        }
+    }
+    
+    static void recordLatency(MetricHistogram histogram, uint64_t nanoseconds) {
+        if (enabled()) {
+            Shard& shard = localShard();
+            increment(shard.buckets[histogram][LatencyHistogram::bucketFor(nanoseconds)], 1);
+            increment(shard.counts[histogram], 1);
+            increment(shard.sums[histogram], nanoseconds);
+        }
+    }
+    
+    // Menghitung hasil pull per rarity, hard pity dan soft pity (pullNumber = counter saat pull)
+    static void recordResults(const GachaResult* results, size_t count, int softPityStart) {
+        if (!enabled()) {
+            return;
+        }
+        uint64_t rarityCounts[RARITY_COUNT] = { 0, 0, 0, 0 };
+        uint64_t hardPity = 0;
+        uint64_t softPityPulls = 0;
+        uint64_t softPitySSR = 0;
+        for (size_t i = 0; i < count; i++) {
+            const GachaResult& result = results[i];
+            rarityCounts[result.rarity]++;
+            if (result.isPity) {
+                hardPity++;
+            } else if (result.pullNumber >= softPityStart) {
+                softPityPulls++;
+                softPitySSR += result.rarity == RARITY_SSR;
+            }
+        }
+        
+        Shard& shard = localShard();
+        increment(shard.counters[METRIC_PULLS], count);
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            increment(shard.counters[METRIC_PULLS_SSR + i], rarityCounts[i]);
+        }
+        increment(shard.counters[METRIC_HARD_PITY], hardPity);
+        increment(shard.counters[METRIC_SOFT_PITY_PULLS], softPityPulls);
+        increment(shard.counters[METRIC_SOFT_PITY_SSR], softPitySSR);
+    }
+    
+    // Menggabungkan semua shard (thread yang sudah selesai tetap dihitung)
+    static MetricsSnapshot snapshot();
+    
+    // Mengosongkan semua counter dan histogram
+    static void reset();
+    
+    // Dump teks format Prometheus
+    static void writePrometheus(std::ostream& out);
+    static bool writePrometheusFile(const std::string& path);
+
+private:
+    static std::atomic<bool>& enabledFlag();
+    static std::atomic<uint32_t>& samplingInterval();
+    static Shard& registerShard();
+    
+    // Hanya thread pemilik yang menulis, jadi cukup load + store relaxed (tanpa lock prefix)
+    static void increment(std::atomic<uint64_t>& value, uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+    
+    static Shard& localShard() {
+        thread_local Shard* shard = nullptr;
+        if (!shard) {
+            shard = &registerShard();
+        }
+        return *shard;
+    }
+};
+
+// Mengukur latensi sebuah scope (tersampel); jam tidak dibaca sama sekali saat metrik mati
+class MetricsTimer {
+private:
+    MetricHistogram histogram;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit MetricsTimer(MetricHistogram histogramValue) :
+        histogram(histogramValue),
+        active(GachaMetrics::sampleLatency(histogramValue)) {
+        if (active) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+    
+    ~MetricsTimer() {
+        if (active) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            GachaMetrics::recordLatency(histogram, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+};
+
+#endif // GACHA_METRICS_H
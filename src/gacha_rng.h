@@ -0,0 +1,320 @@
+#ifndef GACHA_RNG_H
+#define GACHA_RNG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// Jenis generator angka random yang bisa dipilih
+enum RngKind : uint8_t {
+    RNG_MT19937 = 0,      // std::mt19937_64 (kompatibel, paling lambat)
+    RNG_XOSHIRO256SS = 1, // xoshiro256** (tercepat, default)
+    RNG_PCG64 = 2,        // PCG64 XSL-RR 128/64 dengan stream asli
+    RNG_PHILOX4X32 = 3,   // Philox4x32-10 berbasis counter (lompat ke posisi mana pun)
+    RNG_KIND_COUNT = 4
+};
+
+// Nama generator untuk tampilan dan opsi
+inline const char* rngKindName(RngKind kind) {
+    static const char* const names[RNG_KIND_COUNT] = { "mt19937", "xoshiro256**", "pcg64", "philox4x32" };
+    return kind < RNG_KIND_COUNT ? names[kind] : "unknown";
+}
+
+// Konversi cepat 64 bit random menjadi double di [0, 1) memakai 53 bit teratas
+inline double toUnitDouble(uint64_t bits) {
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// SplitMix64: dipakai untuk menurunkan state awal dari seed
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Semua engine punya antarmuka yang sama: seed(seed, stream) dan next() 64 bit
+struct Mt19937Engine {
+    std::mt19937_64 engine;
+    
+    void seed(uint64_t seedValue, uint64_t stream) {
+        std::seed_seq sequence{ static_cast<uint32_t>(seedValue), static_cast<uint32_t>(seedValue >> 32),
+                                static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32) };
+        engine.seed(sequence);
+    }
+    
+    uint64_t next() {
+        return engine();
+    }
+};
+
+struct Xoshiro256ssEngine {
+    uint64_t state[4];
+    
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+    
+    // Stream diturunkan dari seed yang berbeda lewat SplitMix64
+    void seed(uint64_t seedValue, uint64_t stream) {
+        uint64_t mix = seedValue ^ (stream * 0xD1B54A32D192ED03ull);
+        for (int i = 0; i < 4; i++) {
+            state[i] = splitMix64(mix);
+        }
+    }
+    
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+};
+
+// State 128 bit disimpan sebagai dua bagian 64 bit agar portabel (termasuk MSVC)
+struct Pcg64Engine {
+    uint64_t stateHigh;
+    uint64_t stateLow;
+    uint64_t incrementHigh;
+    uint64_t incrementLow;
+    
+    static constexpr uint64_t MULTIPLIER_HIGH = 2549297995355413924ull;
+    static constexpr uint64_t MULTIPLIER_LOW = 4865540595714422341ull;
+    
+    // Perkalian 64 x 64 -> 128 bit
+    static void multiply64(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low) {
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 uint128;
+        uint128 product = static_cast<uint128>(a) * b;
+        high = static_cast<uint64_t>(product >> 64);
+        low = static_cast<uint64_t>(product);
+#else
+        uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+        uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+        uint64_t lowLow = aLow * bLow;
+        uint64_t highLow = aHigh * bLow;
+        uint64_t lowHigh = aLow * bHigh;
+        uint64_t highHigh = aHigh * bHigh;
+        uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFFu) + lowHigh;
+        high = highHigh + (highLow >> 32) + (cross >> 32);
+        low = (cross << 32) | (lowLow & 0xFFFFFFFFu);
+#endif
+    }
+    
+    // state = state * multiplier + increment (mod 2^128)
+    void step() {
+        uint64_t high, low;
+        multiply64(stateLow, MULTIPLIER_LOW, high, low);
+        high += stateLow * MULTIPLIER_HIGH + stateHigh * MULTIPLIER_LOW;
+        stateLow = low + incrementLow;
+        stateHigh = high + incrementHigh + (stateLow < low ? 1 : 0);
+    }
+    
+    // Inisialisasi sesuai referensi PCG: stream menentukan increment (harus ganjil)
+    void seed(uint64_t seedValue, uint64_t stream) {
+        stateHigh = 0;
+        stateLow = 0;
+        incrementHigh = stream >> 63;
+        incrementLow = (stream << 1) | 1u;
+        step();
+        stateLow += seedValue;
+        stateHigh += stateLow < seedValue ? 1 : 0;
+        step();
+    }
+    
+    // Output XSL-RR dari state yang baru
+    uint64_t next() {
+        step();
+        uint64_t xorShifted = stateHigh ^ stateLow;
+        int rotation = static_cast<int>(stateHigh >> 58);
+        return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 63));
+    }
+};
+
+// Philox4x32-10: satu counter menghasilkan 2 angka 64 bit, tepat satu pull
+struct Philox4x32Engine {
+    uint32_t key[2];
+    uint64_t counter;
+    uint32_t streamWords[2];
+    uint64_t buffer[2];
+    int buffered;
+    
+    // Menghitung blok ke-index tanpa mengubah state (10 ronde Philox)
+    void block(uint64_t index, uint64_t out[2]) const {
+        uint32_t c0 = static_cast<uint32_t>(index);
+        uint32_t c1 = static_cast<uint32_t>(index >> 32);
+        uint32_t c2 = streamWords[0];
+        uint32_t c3 = streamWords[1];
+        uint32_t k0 = key[0];
+        uint32_t k1 = key[1];
+        for (int round = 0; round < 10; round++) {
+            uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+            uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+            c0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+            c1 = static_cast<uint32_t>(product1);
+            c2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+            c3 = static_cast<uint32_t>(product0);
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = (static_cast<uint64_t>(c1) << 32) | c0;
+        out[1] = (static_cast<uint64_t>(c3) << 32) | c2;
+    }
+    
+    // Empat blok berurutan sekaligus; ronde-ronde yang independen bisa berjalan paralel di CPU
+    void blocks4(uint64_t firstIndex, uint64_t out[8]) const {
+        uint32_t c0[4], c1[4], c2[4], c3[4];
+        for (int lane = 0; lane < 4; lane++) {
+            c0[lane] = static_cast<uint32_t>(firstIndex + lane);
+            c1[lane] = static_cast<uint32_t>((firstIndex + lane) >> 32);
+            c2[lane] = streamWords[0];
+            c3[lane] = streamWords[1];
+        }
+        uint32_t k0 = key[0];
+        uint32_t k1 = key[1];
+        for (int round = 0; round < 10; round++) {
+            for (int lane = 0; lane < 4; lane++) {
+                uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0[lane];
+                uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2[lane];
+                c0[lane] = static_cast<uint32_t>(product1 >> 32) ^ c1[lane] ^ k0;
+                c1[lane] = static_cast<uint32_t>(product1);
+                c2[lane] = static_cast<uint32_t>(product0 >> 32) ^ c3[lane] ^ k1;
+                c3[lane] = static_cast<uint32_t>(product0);
+            }
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        for (int lane = 0; lane < 4; lane++) {
+            out[2 * lane] = (static_cast<uint64_t>(c1[lane]) << 32) | c0[lane];
+            out[2 * lane + 1] = (static_cast<uint64_t>(c3[lane]) << 32) | c2[lane];
+        }
+    }
+    
+    void seed(uint64_t seedValue, uint64_t stream) {
+        key[0] = static_cast<uint32_t>(seedValue);
+        key[1] = static_cast<uint32_t>(seedValue >> 32);
+        streamWords[0] = static_cast<uint32_t>(stream);
+        streamWords[1] = static_cast<uint32_t>(stream >> 32);
+        seek(0);
+    }
+    
+    // Lompat langsung ke blok tertentu (O(1))
+    void seek(uint64_t blockIndex) {
+        counter = blockIndex;
+        buffered = 0;
+    }
+    
+    uint64_t next() {
+        if (buffered == 0) {
+            block(counter++, buffer);
+            buffered = 2;
+        }
+        return buffer[2 - buffered--];
+    }
+};
+
+// Mengisi buffer dengan angka random [0, 1) dari engine tertentu
+template <typename Engine>
+inline void fillUniforms(Engine& engine, double* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = toUnitDouble(engine.next());
+    }
+}
+
+// Philox: blok penuh ditulis langsung tanpa lewat buffer
+inline void fillUniforms(Philox4x32Engine& engine, double* out, size_t count) {
+    size_t i = 0;
+    for (; i < count && engine.buffered > 0; i++) {
+        out[i] = toUnitDouble(engine.next());
+    }
+    for (; i + 8 <= count; i += 8) {
+        uint64_t words[8];
+        engine.blocks4(engine.counter, words);
+        engine.counter += 4;
+        for (int j = 0; j < 8; j++) {
+            out[i + j] = toUnitDouble(words[j]);
+        }
+    }
+    for (; i + 2 <= count; i += 2) {
+        uint64_t words[2];
+        engine.block(engine.counter++, words);
+        out[i] = toUnitDouble(words[0]);
+        out[i + 1] = toUnitDouble(words[1]);
+    }
+    for (; i < count; i++) {
+        out[i] = toUnitDouble(engine.next());
+    }
+}
+
+// Generator yang bisa dipilih saat runtime; pilihan engine dicek sekali per buffer
+class GachaRng {
+private:
+    RngKind kind;
+    uint64_t seedValue;
+    uint64_t streamValue;
+    Mt19937Engine mt19937;
+    Xoshiro256ssEngine xoshiro;
+    Pcg64Engine pcg;
+    Philox4x32Engine philox;
+
+public:
+    GachaRng() {
+        seed(RNG_XOSHIRO256SS, 0, 0);
+    }
+    
+    // Seed ulang dengan engine, seed dan stream tertentu
+    void seed(RngKind kindValue, uint64_t seedNumber, uint64_t stream) {
+        kind = kindValue < RNG_KIND_COUNT ? kindValue : RNG_XOSHIRO256SS;
+        seedValue = seedNumber;
+        streamValue = stream;
+        switch (kind) {
+            case RNG_MT19937: mt19937.seed(seedNumber, stream); break;
+            case RNG_PCG64: pcg.seed(seedNumber, stream); break;
+            case RNG_PHILOX4X32: philox.seed(seedNumber, stream); break;
+            default: xoshiro.seed(seedNumber, stream); break;
+        }
+    }
+    
+    RngKind getKind() const {
+        return kind;
+    }
+    
+    uint64_t getSeed() const {
+        return seedValue;
+    }
+    
+    uint64_t getStream() const {
+        return streamValue;
+    }
+    
+    // Memindahkan stream ke blok tertentu (satu blok = satu pull); hanya philox4x32 yang bisa melompat, false jika bukan
+    bool seek(uint64_t blockIndex) {
+        if (kind != RNG_PHILOX4X32) {
+            return false;
+        }
+        philox.seek(blockIndex);
+        return true;
+    }
+    
+    double nextDouble() {
+        double value;
+        fill(&value, 1);
+        return value;
+    }
+    
+    void fill(double* out, size_t count) {
+        switch (kind) {
+            case RNG_MT19937: fillUniforms(mt19937, out, count); break;
+            case RNG_PCG64: fillUniforms(pcg, out, count); break;
+            case RNG_PHILOX4X32: fillUniforms(philox, out, count); break;
+            default: fillUniforms(xoshiro, out, count); break;
+        }
+    }
+};
+
+#endif // GACHA_RNG_H
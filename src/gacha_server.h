@@ -0,0 +1,644 @@
+#ifndef GACHA_SERVER_H
+#define GACHA_SERVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "banner_registry.h"
+#include "gacha_catalog.h"
+#include "gacha_metrics.h"
+#include "gacha_rng.h"
+#include "gacha_types.h"
+#include "pull_log.h"
+#include "snapshot.h"
+
+// Satu permintaan pull di GachaServer::pullBatch()
+struct PullRequest {
+    uint64_t playerId;
+    uint32_t bannerId;
+    uint32_t count;
+};
+
+// Server banyak pemain: registry banner bersama, state pity disimpan per shard dalam array kolom.
+// Setiap pemain punya satu counter pity dan state rate-up per jalur pity, dan satu karakter pity per banner.
+// Pemain id masuk ke shard id % jumlah shard, sehingga thread yang melayani pemain berbeda jarang berebut lock
+class GachaServer {
+private:
+    // Jumlah pull per blok angka random saat melayani satu permintaan
+    static constexpr size_t RANDOM_BLOCK = 256;
+    
+    // Record catatan pull yang ditampung per shard sebelum ditulis ke file
+    static constexpr size_t LOG_BUFFER_RECORDS = 4096;
+    
+    // Satu shard menempati cache line sendiri agar lock antar shard tidak saling mengganggu
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::shared_ptr<const BannerRegistry> banners;  // Salinan pointer per shard (refcount tidak diperebutkan)
+        std::vector<int32_t> pullCounts;                // [pemain * jumlah jalur + jalur] pull sejak SSR terakhir
+        std::vector<uint32_t> selectedCharPity;         // [pemain * jumlah banner + banner] karakter pity
+        std::vector<uint8_t> featuredStates;            // [pemain * jumlah jalur + jalur] state rate-up
+        std::vector<uint64_t> pullIndices;              // Posisi stream random per pemain
+        std::vector<PullLogRecord> logBuffer;           // Record yang belum ditulis ke catatan pull
+        uint64_t totalPulls;
+        
+        Shard() : totalPulls(0) {}
+    };
+    
+    size_t shardCount;
+    std::unique_ptr<Shard[]> shards;
+    uint64_t seedValue;
+    std::mutex registerMutex;           // Dipakai saat menambah pemain, mengganti banner atau memuat snapshot
+    std::atomic<uint64_t> playerTotal;
+    PullLog* pullLog;                   // Catatan pull opsional (nullptr = tidak dicatat)
+    
+    Shard& shardOf(uint64_t playerId) const {
+        return shards[playerId % shardCount];
+    }
+    
+    size_t localIndex(uint64_t playerId) const {
+        return static_cast<size_t>(playerId / shardCount);
+    }
+    
+    // Jumlah pemain shard tertentu jika ada total pemain dengan ID berurutan
+    size_t shardSize(size_t shard, uint64_t total) const {
+        return static_cast<size_t>(total / shardCount + (shard < total % shardCount ? 1 : 0));
+    }
+    
+    // Mengubah jumlah pemain menjadi total (registerMutex harus dipegang)
+    void resizePlayers(uint64_t total) {
+        for (size_t i = 0; i < shardCount; i++) {
+            size_t size = shardSize(i, total);
+            Shard& shard = shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.pullCounts.resize(size * shard.banners->trackCount(), 0);
+            shard.featuredStates.resize(size * shard.banners->trackCount(), 0);
+            shard.selectedCharPity.resize(size * shard.banners->size(), 0);
+            shard.pullIndices.resize(size, 0);
+        }
+        playerTotal.store(total);
+    }
+    
+    // Menyusun ulang kolom per pemain dari oldStride menjadi newStride nilai; kolom baru diisi 0
+    template <typename T>
+    static void restride(std::vector<T>& column, size_t players, size_t oldStride, size_t newStride) {
+        if (oldStride == newStride) {
+            return;
+        }
+        std::vector<T> next(players * newStride, 0);
+        for (size_t player = 0; player < players; player++) {
+            std::copy(column.begin() + player * oldStride, column.begin() + (player + 1) * oldStride,
+                      next.begin() + player * newStride);
+        }
+        column.swap(next);
+    }
+    
+    // Memasang registry baru yang memperluas registry lama ke semua shard (registerMutex harus dipegang).
+    // Counter di jalur yang hard pity-nya turun dipotong agar garansi jatuh pada pull berikutnya
+    void publishBanners(std::shared_ptr<const BannerRegistry> registry) {
+        for (size_t i = 0; i < shardCount; i++) {
+            Shard& shard = shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const BannerRegistry& previous = *shard.banners;
+            size_t players = shard.pullIndices.size();
+            size_t tracks = registry->trackCount();
+            restride(shard.pullCounts, players, previous.trackCount(), tracks);
+            restride(shard.featuredStates, players, previous.trackCount(), tracks);
+            restride(shard.selectedCharPity, players, previous.size(), registry->size());
+            for (size_t track = 0; track < previous.trackCount(); track++) {
+                int32_t limit = registry->getTrackHardPity(static_cast<uint32_t>(track)) - 1;
+                if (limit + 1 >= previous.getTrackHardPity(static_cast<uint32_t>(track))) {
+                    continue;
+                }
+                for (size_t player = 0; player < players; player++) {
+                    int32_t& pullCount = shard.pullCounts[player * tracks + track];
+                    pullCount = std::min(pullCount, limit);
+                }
+            }
+            shard.banners = registry;
+        }
+    }
+    
+    // Menulis record yang tertampung di satu shard (lock shard harus dipegang)
+    void flushShardLog(Shard& shard) {
+        if (pullLog && !shard.logBuffer.empty()) {
+            pullLog->append(shard.logBuffer.data(), shard.logBuffer.size());
+        }
+        shard.logBuffer.clear();
+    }
+    
+    // Inti pull(): count pull satu pemain di shard-nya (lock shard harus dipegang, ID pemain sudah dicek).
+    // False tanpa perubahan jika ID banner tidak dikenal
+    bool pullLocked(Shard& shard, uint64_t playerId, uint32_t bannerId, GachaResult* out, size_t count) {
+        size_t index = localIndex(playerId);
+        
+        Philox4x32Engine engine;
+        engine.seed(seedValue, playerId);
+        double uniforms[2 * RANDOM_BLOCK];
+        const BannerRegistry& registry = *shard.banners;
+        if (bannerId >= registry.size()) {
+            return false;
+        }
+        const BannerEntry& banner = registry.getBanner(bannerId);
+        const GachaCatalog& catalog = *banner.catalog;
+        size_t trackIndex = index * registry.trackCount() + banner.pityTrack;
+        PityState state;
+        state.pullCount = shard.pullCounts[trackIndex];
+        state.selectedCharPity = shard.selectedCharPity[index * registry.size() + bannerId];
+        state.featuredState = shard.featuredStates[trackIndex];
+        uint8_t featuredState = state.featuredState;
+        
+        // Satu blok Philox = satu pull, jadi posisi stream sama dengan jumlah pull pemain di semua banner
+        uint64_t pullIndex = shard.pullIndices[index];
+        engine.seek(pullIndex);
+        for (size_t done = 0; done < count; done += RANDOM_BLOCK) {
+            size_t blockSize = std::min(RANDOM_BLOCK, count - done);
+            fillUniforms(engine, uniforms, 2 * blockSize);
+            catalog.resolveBatch(state, uniforms, blockSize, out + done);
+        }
+        if (bannerId != 0) {
+            for (size_t i = 0; i < count; i++) {
+                out[i].bannerId = static_cast<uint8_t>(bannerId);
+            }
+        }
+        
+        shard.pullCounts[trackIndex] = state.pullCount;
+        shard.featuredStates[trackIndex] = state.featuredState;
+        shard.pullIndices[index] += count;
+        shard.totalPulls += count;
+        
+        // Catatan pull ditampung per shard lalu ditulis berurutan dalam potongan besar.
+        // State rate-up sebelum setiap pull diturunkan dari SSR sebelumnya, sama seperti saat pull
+        if (pullLog) {
+            for (size_t i = 0; i < count; i++) {
+                PullLogRecord record = makePullLogRecord(playerId, pullIndex + i, out[i]);
+                record.selectedCharPity = state.selectedCharPity;
+                record.bannerVersion = banner.version;
+                record.featuredState = featuredState;
+                shard.logBuffer.push_back(record);
+                if (out[i].rarity == RARITY_SSR) {
+                    featuredState = catalog.nextFeaturedState(featuredState, out[i].characterId, state.selectedCharPity);
+                }
+            }
+            if (shard.logBuffer.size() >= LOG_BUFFER_RECORDS) {
+                flushShardLog(shard);
+            }
+        }
+        return true;
+    }
+    
+    // Registry berisi satu banner untuk server yang dibuat dari satu katalog
+    static std::shared_ptr<const BannerRegistry> singleBanner(std::shared_ptr<const GachaCatalog> gachaCatalog) {
+        std::shared_ptr<BannerRegistry> registry = std::make_shared<BannerRegistry>();
+        registry->addBanner(DEFAULT_BANNER, gachaCatalog, DEFAULT_BANNER);
+        return registry;
+    }
+
+public:
+    // Nama banner dan jalur pity untuk server satu katalog
+    static constexpr const char* DEFAULT_BANNER = "default";
+    
+    // Setiap pemain memakai stream Philox sendiri (key = seed server, stream = ID pemain),
+    // jadi hasil pull hanya bergantung pada seed, ID pemain dan urutan pull pemain itu.
+    // Registry minimal berisi satu banner; banner 0 dipakai oleh fungsi tanpa ID banner
+    GachaServer(std::shared_ptr<const BannerRegistry> registry, uint64_t seed, size_t shardTotal = 64) :
+        shardCount(std::max<size_t>(1, shardTotal)),
+        shards(new Shard[std::max<size_t>(1, shardTotal)]),
+        seedValue(seed),
+        playerTotal(0),
+        pullLog(nullptr) {
+        for (size_t i = 0; i < shardCount; i++) {
+            shards[i].banners = registry;
+        }
+    }
+    
+    // Server satu banner (katalog yang belum dikompilasi disalin lalu dikompilasi)
+    GachaServer(std::shared_ptr<const GachaCatalog> gachaCatalog, uint64_t seed, size_t shardTotal = 64) :
+        GachaServer(singleBanner(gachaCatalog), seed, shardTotal) {}
+    
+    uint64_t playerCount() const {
+        return playerTotal.load();
+    }
+    
+    size_t getShardCount() const {
+        return shardCount;
+    }
+    
+    // Menambah count pemain baru, mengembalikan ID pemain pertama (ID berurutan)
+    uint64_t addPlayers(uint64_t count) {
+        std::lock_guard<std::mutex> registerLock(registerMutex);
+        uint64_t firstId = playerTotal.load();
+        resizePlayers(firstId + count);
+        return firstId;
+    }
+    
+    // Melakukan count pull di satu banner untuk satu pemain ke buffer milik pemanggil, aman dari banyak thread.
+    // Lookup banner O(1), katalognya dipakai langsung tanpa disalin. False jika ID pemain atau banner tidak dikenal
+    bool pull(uint64_t playerId, uint32_t bannerId, GachaResult* out, size_t count) {
+        if (playerId >= playerTotal.load()) {
+            return false;
+        }
+        
+        MetricsTimer timer(HISTOGRAM_SERVER_PULL);
+        Shard& shard = shardOf(playerId);
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        if (!pullLocked(shard, playerId, bannerId, out, count)) {
+            return false;
+        }
+        int softPityStart = shard.banners->getBanner(bannerId).catalog->getSoftPityStart();
+        lock.unlock();
+        
+        GachaMetrics::recordResults(out, count, softPityStart);
+        return true;
+    }
+    
+    // Menjalankan count permintaan sekaligus. Hasil permintaan i ditulis berurutan di out mulai dari
+    // jumlah count permintaan sebelumnya; ok[i] false (hasilnya tidak diisi) jika ID pemain atau banner
+    // tidak dikenal. Permintaan dikelompokkan per shard sehingga lock tiap shard hanya diambil sekali,
+    // dan permintaan pemain yang sama dijalankan sesuai urutannya di array
+    void pullBatch(const PullRequest* requests, size_t count, GachaResult* out, bool* ok) {
+        MetricsTimer timer(HISTOGRAM_SERVER_BATCH);
+        GachaMetrics::add(METRIC_SERVER_BATCHES);
+        
+        // Offset hasil per permintaan dan urutan permintaan per shard (stabil, counting sort)
+        std::vector<size_t> offsets(count);
+        std::vector<size_t> shardStarts(shardCount + 1, 0);
+        size_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            offsets[i] = total;
+            total += requests[i].count;
+            shardStarts[requests[i].playerId % shardCount + 1]++;
+        }
+        for (size_t i = 0; i < shardCount; i++) {
+            shardStarts[i + 1] += shardStarts[i];
+        }
+        std::vector<size_t> order(count);
+        std::vector<int> softPityStarts(count);
+        std::vector<size_t> fill(shardStarts.begin(), shardStarts.end() - 1);
+        for (size_t i = 0; i < count; i++) {
+            order[fill[requests[i].playerId % shardCount]++] = i;
+        }
+        
+        uint64_t players = playerTotal.load();
+        for (size_t i = 0; i < shardCount; i++) {
+            if (shardStarts[i] == shardStarts[i + 1]) {
+                continue;
+            }
+            Shard& shard = shards[i];
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            for (size_t k = shardStarts[i]; k < shardStarts[i + 1]; k++) {
+                size_t r = order[k];
+                const PullRequest& request = requests[r];
+                ok[r] = request.playerId < players &&
+                        pullLocked(shard, request.playerId, request.bannerId, out + offsets[r], request.count);
+                if (ok[r]) {
+                    softPityStarts[r] = shard.banners->getBanner(request.bannerId).catalog->getSoftPityStart();
+                }
+            }
+            lock.unlock();
+            
+            for (size_t k = shardStarts[i]; k < shardStarts[i + 1]; k++) {
+                size_t r = order[k];
+                if (ok[r]) {
+                    GachaMetrics::recordResults(out + offsets[r], requests[r].count, softPityStarts[r]);
+                }
+            }
+        }
+    }
+    
+    // Pull di banner 0
+    bool pull(uint64_t playerId, GachaResult* out, size_t count) {
+        return pull(playerId, 0, out, count);
+    }
+    
+    // Melakukan multiple pull untuk satu pemain di satu banner
+    std::vector<GachaResult> multiPull(uint64_t playerId, uint32_t bannerId, int count) {
+        std::vector<GachaResult> results(count > 0 ? count : 0);
+        if (!pull(playerId, bannerId, results.data(), results.size())) {
+            results.clear();
+        }
+        return results;
+    }
+    
+    std::vector<GachaResult> multiPull(uint64_t playerId, int count) {
+        return multiPull(playerId, 0, count);
+    }
+    
+    // Set karakter pity seorang pemain di satu banner, false jika ID pemain, banner atau karakter tidak valid
+    bool setSelectedCharPity(uint64_t playerId, uint32_t bannerId, uint32_t characterId) {
+        if (playerId >= playerTotal.load()) {
+            return false;
+        }
+        Shard& shard = shardOf(playerId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const BannerRegistry& registry = *shard.banners;
+        if (bannerId >= registry.size() || !registry.getBanner(bannerId).catalog->isActive(characterId)) {
+            return false;
+        }
+        shard.selectedCharPity[localIndex(playerId) * registry.size() + bannerId] = characterId;
+        return true;
+    }
+    
+    bool setSelectedCharPity(uint64_t playerId, uint32_t characterId) {
+        return setSelectedCharPity(playerId, 0, characterId);
+    }
+    
+    // Salinan state pity seorang pemain di satu banner: counter dan state rate-up jalur pity banner itu
+    // serta karakter pity-nya (pullCount -1 jika ID pemain atau banner tidak valid)
+    PityState getPityState(uint64_t playerId, uint32_t bannerId) const {
+        PityState state;
+        state.pullCount = -1;
+        state.selectedCharPity = 0;
+        state.featuredState = 0;
+        if (playerId < playerTotal.load()) {
+            Shard& shard = shardOf(playerId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const BannerRegistry& registry = *shard.banners;
+            if (bannerId < registry.size()) {
+                size_t index = localIndex(playerId);
+                size_t trackIndex = index * registry.trackCount() + registry.getBanner(bannerId).pityTrack;
+                state.pullCount = shard.pullCounts[trackIndex];
+                state.selectedCharPity = shard.selectedCharPity[index * registry.size() + bannerId];
+                state.featuredState = shard.featuredStates[trackIndex];
+            }
+        }
+        return state;
+    }
+    
+    PityState getPityState(uint64_t playerId) const {
+        return getPityState(playerId, 0);
+    }
+    
+    // Mengganti daftar banner untuk semua shard (pull yang sedang berjalan memakai registry lama sampai selesai).
+    // Registry baru hanya boleh menambah banner dan jalur di akhir, false jika tidak
+    bool setBanners(std::shared_ptr<const BannerRegistry> registry) {
+        std::lock_guard<std::mutex> registerLock(registerMutex);
+        if (registry->size() == 0 || !registry->extends(*getBanners())) {
+            return false;
+        }
+        publishBanners(registry);
+        return true;
+    }
+    
+    std::shared_ptr<const BannerRegistry> getBanners() const {
+        std::lock_guard<std::mutex> lock(shards[0].mutex);
+        return shards[0].banners;
+    }
+    
+    // Mengganti katalog banner 0. Perubahan live: salin katalog, ubah salinannya, compile(), lalu publikasikan di sini.
+    // False jika hard pity-nya berbeda dengan banner lain yang berbagi jalur pity
+    bool setCatalog(std::shared_ptr<const GachaCatalog> gachaCatalog) {
+        std::lock_guard<std::mutex> registerLock(registerMutex);
+        std::shared_ptr<BannerRegistry> registry = std::make_shared<BannerRegistry>(*getBanners());
+        if (!registry->replaceCatalog(0, gachaCatalog)) {
+            return false;
+        }
+        publishBanners(registry);
+        return true;
+    }
+    
+    std::shared_ptr<const GachaCatalog> getCatalog() const {
+        return getBanners()->getBanner(0).catalog;
+    }
+    
+    // Total pull yang sudah dilayani semua shard
+    uint64_t totalPulls() const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < shardCount; i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            total += shards[i].totalPulls;
+        }
+        return total;
+    }
+    
+    // Seed stream random semua pemain (berubah setelah loadSnapshot())
+    uint64_t getSeed() const {
+        return seedValue;
+    }
+    
+    // Memasang catatan pull append-only (nullptr = berhenti mencatat); dipanggil sebelum melayani pull.
+    // Catatan versi 2 harus dibuka dengan seed server ini dan engine philox4x32, false (tidak dipasang) jika tidak
+    bool setPullLog(PullLog* log) {
+        if (log && log->hasSeed() && (log->getSeed() != seedValue || log->getRngKind() != RNG_PHILOX4X32)) {
+            return false;
+        }
+        flushLog();
+        pullLog = log;
+        return true;
+    }
+    
+    // Menulis semua record yang masih tertampung ke catatan pull
+    void flushLog() {
+        for (size_t i = 0; i < shardCount; i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            flushShardLog(shards[i]);
+        }
+        if (pullLog) {
+            pullLog->flush();
+        }
+    }
+    
+    // Menyimpan banner dan state semua pemain ke satu snapshot yang konsisten (semua shard dikunci)
+    bool saveSnapshot(const std::string& path) {
+        std::lock_guard<std::mutex> registerLock(registerMutex);
+        std::vector<std::unique_lock<std::mutex>> locks;
+        for (size_t i = 0; i < shardCount; i++) {
+            locks.emplace_back(shards[i].mutex);
+        }
+        
+        // Kolom shard disusun ulang menjadi urutan ID pemain
+        const BannerRegistry& registry = *shards[0].banners;
+        size_t tracks = registry.trackCount();
+        size_t bannerCount = registry.size();
+        uint64_t total = playerTotal.load();
+        std::vector<int32_t> pullCounts(total * tracks);
+        std::vector<uint32_t> selected(total * bannerCount);
+        std::vector<uint64_t> pullIndices(total);
+        std::vector<uint8_t> featuredStates(total * tracks);
+        for (uint64_t id = 0; id < total; id++) {
+            const Shard& shard = shardOf(id);
+            size_t index = localIndex(id);
+            std::copy(shard.pullCounts.begin() + index * tracks, shard.pullCounts.begin() + (index + 1) * tracks,
+                      pullCounts.begin() + id * tracks);
+            std::copy(shard.featuredStates.begin() + index * tracks, shard.featuredStates.begin() + (index + 1) * tracks,
+                      featuredStates.begin() + id * tracks);
+            std::copy(shard.selectedCharPity.begin() + index * bannerCount,
+                      shard.selectedCharPity.begin() + (index + 1) * bannerCount, selected.begin() + id * bannerCount);
+            pullIndices[id] = shard.pullIndices[index];
+        }
+        
+        SnapshotWriter writer;
+        registry.writeTo(writer);
+        PlayerColumns players;
+        players.count = total;
+        players.seed = seedValue;
+        players.trackCount = static_cast<uint32_t>(tracks);
+        players.bannerCount = static_cast<uint32_t>(bannerCount);
+        players.pullCounts = pullCounts.data();
+        players.selectedCharPity = selected.data();
+        players.pullIndices = pullIndices.data();
+        players.featuredStates = featuredStates.data();
+        players.writeTo(writer);
+        return writer.writeFile(path);
+    }
+    
+    // Mengganti banner, seed dan semua pemain dengan isi snapshot (dipanggil sebelum melayani pull).
+    // Snapshot lama tanpa daftar banner dimuat sebagai satu banner. Kolom dibaca langsung dari file
+    // yang dipetakan ke memori, tanpa parsing per pemain
+    bool loadSnapshot(const std::string& path) {
+        SnapshotFile file;
+        SnapshotReader catalogReader(nullptr, 0, 0);
+        SnapshotReader playerReader(nullptr, 0, 0);
+        if (!file.open(path) || !file.findSection(SECTION_PLAYERS, playerReader)) {
+            return false;
+        }
+        
+        std::shared_ptr<BannerRegistry> registry = std::make_shared<BannerRegistry>();
+        if (!registry->readFrom(file)) {
+            std::shared_ptr<GachaCatalog> catalog = std::make_shared<GachaCatalog>();
+            if (!file.findSection(SECTION_CATALOG, catalogReader) || !catalog->readFrom(catalogReader)) {
+                return false;
+            }
+            registry->addBanner(DEFAULT_BANNER, catalog, DEFAULT_BANNER);
+        }
+        PlayerColumns players;
+        if (!players.readFrom(playerReader) || !registry->accepts(players)) {
+            return false;
+        }
+        
+        std::lock_guard<std::mutex> registerLock(registerMutex);
+        size_t tracks = players.trackCount;
+        size_t bannerCount = players.bannerCount;
+        seedValue = players.seed;
+        for (size_t i = 0; i < shardCount; i++) {
+            Shard& shard = shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            size_t size = shardSize(i, players.count);
+            shard.banners = registry;
+            shard.pullCounts.resize(size * tracks);
+            shard.featuredStates.resize(size * tracks);
+            shard.selectedCharPity.resize(size * bannerCount);
+            shard.pullIndices.resize(size);
+            shard.logBuffer.clear();
+            for (size_t index = 0; index < size; index++) {
+                uint64_t id = index * shardCount + i;
+                std::copy(players.pullCounts + id * tracks, players.pullCounts + (id + 1) * tracks,
+                          shard.pullCounts.begin() + index * tracks);
+                for (size_t track = 0; track < tracks; track++) {
+                    shard.featuredStates[index * tracks + track] = players.featuredStateOf(id, static_cast<uint32_t>(track));
+                }
+                std::copy(players.selectedCharPity + id * bannerCount, players.selectedCharPity + (id + 1) * bannerCount,
+                          shard.selectedCharPity.begin() + index * bannerCount);
+                shard.pullIndices[index] = players.pullIndices[id];
+            }
+        }
+        playerTotal.store(players.count);
+        return true;
+    }
+    
+    // Menerapkan catatan pull yang ditulis setelah snapshot terakhir. Record yang sudah
+    // tercakup snapshot dilewati (pullIndex dicek), jadi aman diputar ulang lebih dari sekali.
+    // Catatan versi 2 harus ber-seed server ini dengan engine philox4x32, dan record yang diterapkan harus
+    // memakai versi katalog banner yang terdaftar (setelah setCatalog() simpan snapshot baru); karakter
+    // pity-nya ikut dipulihkan. Pemain baru (ditambah setelah snapshot) mulai dari pullIndex 0, dengan ID
+    // paling jauh max(jumlah record, jumlah pemain) di atas pemain terakhir.
+    // False tanpa perubahan jika file rusak, ada celah pullIndex, atau record tidak cocok dengan server
+    bool replayLog(const std::string& path) {
+        MappedFile mapped;
+        const PullLogRecord* records = nullptr;
+        size_t count = 0;
+        std::vector<PullLogRecord> converted;
+        if (!mapped.open(path) || !PullLog::records(mapped, records, count, converted)) {
+            return false;
+        }
+        
+        // Catatan versi 1 tidak punya seed dan kolom audit, jadi hanya urutan dan hasilnya yang diterapkan
+        uint64_t seed = 0;
+        RngKind kind = RNG_PHILOX4X32;
+        bool audited = PullLog::readHeader(mapped.bytes(), mapped.length(), seed, kind);
+        if (audited && (seed != seedValue || kind != RNG_PHILOX4X32)) {
+            return false;
+        }
+        
+        std::lock_guard<std::mutex> registerLock(registerMutex);
+        std::shared_ptr<const BannerRegistry> banners = getBanners();
+        const BannerRegistry& registry = *banners;
+        
+        // Pemeriksaan seluruh catatan sebelum ada yang diubah; posisi stream setiap pemain diikuti
+        // untuk menentukan record mana yang akan diterapkan
+        uint64_t players = playerTotal.load();
+        uint64_t limit = players + std::max<uint64_t>(count, players);
+        uint64_t total = players;
+        std::unordered_map<uint64_t, uint64_t> nextIndices;
+        for (size_t i = 0; i < count; i++) {
+            const PullLogRecord& record = records[i];
+            if (record.bannerId >= registry.size() || record.playerId >= limit) {
+                return false;
+            }
+            std::pair<std::unordered_map<uint64_t, uint64_t>::iterator, bool> inserted =
+                nextIndices.try_emplace(record.playerId, 0);
+            if (inserted.second && record.playerId < players) {
+                Shard& shard = shardOf(record.playerId);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                inserted.first->second = shard.pullIndices[localIndex(record.playerId)];
+            }
+            uint64_t& nextIndex = inserted.first->second;
+            if (record.pullIndex < nextIndex) {
+                continue;
+            }
+            if (record.pullIndex > nextIndex) {
+                return false;
+            }
+            const BannerEntry& banner = registry.getBanner(record.bannerId);
+            if (record.pullNumber < 1 || record.pullNumber > banner.catalog->getHardPity()) {
+                return false;
+            }
+            if (audited && (record.bannerVersion != banner.version ||
+                            (record.selectedCharPity != 0 && record.selectedCharPity >= banner.catalog->size()))) {
+                return false;
+            }
+            nextIndex++;
+            total = std::max(total, record.playerId + 1);
+        }
+        if (total > players) {
+            resizePlayers(total);
+        }
+        
+        size_t tracks = registry.trackCount();
+        for (size_t i = 0; i < count; i++) {
+            const PullLogRecord& record = records[i];
+            Shard& shard = shardOf(record.playerId);
+            size_t index = localIndex(record.playerId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (record.pullIndex != shard.pullIndices[index]) {
+                continue;
+            }
+            Rarity rarity = static_cast<Rarity>(record.flags & ~PITY_FLAG);
+            const BannerEntry& banner = registry.getBanner(record.bannerId);
+            size_t trackIndex = index * tracks + banner.pityTrack;
+            shard.pullCounts[trackIndex] = rarity == RARITY_SSR ? 0 : record.pullNumber;
+            
+            // State rate-up diturunkan dari state dan karakter pilihan yang tercatat sebelum pull
+            if (audited) {
+                shard.selectedCharPity[index * registry.size() + record.bannerId] = record.selectedCharPity;
+                shard.featuredStates[trackIndex] = record.featuredState;
+                if (rarity == RARITY_SSR) {
+                    shard.featuredStates[trackIndex] = banner.catalog->nextFeaturedState(
+                        record.featuredState, record.characterId, record.selectedCharPity);
+                }
+            }
+            shard.pullIndices[index]++;
+            shard.totalPulls++;
+        }
+        return true;
+    }
+};
+
+#endif // GACHA_SERVER_H
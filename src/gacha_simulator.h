@@ -0,0 +1,198 @@
+#ifndef GACHA_SIMULATOR_H
+#define GACHA_SIMULATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_rng.h"
+#include "gacha_types.h"
+
+// Pengaturan simulasi Monte Carlo
+struct SimulationConfig {
+    uint64_t trials;            // Jumlah pemain (trajectory) yang disimulasikan
+    uint64_t seed;              // Seed utama, hasil sama untuk seed yang sama
+    RngKind rngKind;            // Engine random; setiap potongan kerja memakai stream sendiri
+    unsigned threads;           // 0 = semua core
+    uint32_t targetCharacterId; // Karakter yang dicari, NO_CHARACTER = tidak dihitung
+    uint32_t pityCharacterId;   // Karakter yang didapat saat hard pity (karakter pilihan di banner rate-up)
+    uint8_t featuredState;      // State rate-up awal setiap trajectory (mis. sedang garansi)
+    int maxPullsPerTrial;       // Batas pull per trajectory saat mencari target (minimal hard pity banner)
+    
+    SimulationConfig() :
+        trials(100000),
+        seed(0),
+        rngKind(RNG_PHILOX4X32),
+        threads(0),
+        targetCharacterId(NO_CHARACTER),
+        pityCharacterId(0),
+        featuredState(0),
+        maxPullsPerTrial(1000) {}
+};
+
+// Hasil simulasi berupa histogram: index = jumlah pull yang dibutuhkan
+struct SimulationResult {
+    static constexpr int CURRENCY_PER_PULL = 160;
+    
+    uint64_t trials;
+    std::vector<uint64_t> pullsToFirstSSR;
+    std::vector<uint64_t> pullsToTarget;
+    uint64_t targetNotReached;  // Trajectory yang tidak mendapat target sampai batas
+    
+    SimulationResult() : trials(0), targetNotReached(0) {}
+    
+    // Rata-rata dari sebuah histogram
+    static double mean(const std::vector<uint64_t>& histogram) {
+        uint64_t count = 0;
+        double sum = 0.0;
+        for (size_t pulls = 0; pulls < histogram.size(); pulls++) {
+            count += histogram[pulls];
+            sum += static_cast<double>(pulls) * histogram[pulls];
+        }
+        return count > 0 ? sum / count : 0.0;
+    }
+    
+    // Jumlah pull terkecil yang mencakup fraksi p (0..1) dari histogram
+    static int percentile(const std::vector<uint64_t>& histogram, double p) {
+        uint64_t count = 0;
+        for (uint64_t value : histogram) {
+            count += value;
+        }
+        uint64_t cumulative = 0;
+        for (size_t pulls = 0; pulls < histogram.size(); pulls++) {
+            cumulative += histogram[pulls];
+            if (count > 0 && cumulative >= p * count) {
+                return static_cast<int>(pulls);
+            }
+        }
+        return static_cast<int>(histogram.size()) - 1;
+    }
+    
+    // Currency rata-rata untuk mendapat SSR pertama
+    double meanCurrencyToFirstSSR() const {
+        return mean(pullsToFirstSSR) * CURRENCY_PER_PULL;
+    }
+    
+    double meanCurrencyToTarget() const {
+        return mean(pullsToTarget) * CURRENCY_PER_PULL;
+    }
+};
+
+// Mesin simulasi Monte Carlo di atas katalog bersama, tanpa menyentuh state pemain mana pun
+class GachaSimulator {
+private:
+    // Jumlah trajectory per potongan kerja; setiap potongan punya stream random sendiri
+    static constexpr uint64_t CHUNK_TRIALS = 4096;
+    
+    const GachaCatalog& catalog;
+    
+    // Menjalankan satu potongan trajectory dan menambahkan hasilnya ke histogram lokal
+    void runChunk(const SimulationConfig& config, int maxPulls, uint64_t chunk, SimulationResult& local) const {
+        GachaRng rng;
+        rng.seed(config.rngKind, config.seed, chunk);
+        
+        bool trackTarget = config.targetCharacterId != NO_CHARACTER;
+        
+        uint64_t first = chunk * CHUNK_TRIALS;
+        uint64_t last = std::min(first + CHUNK_TRIALS, config.trials);
+        for (uint64_t trial = first; trial < last; trial++) {
+            PityState state;
+            state.pullCount = 0;
+            state.selectedCharPity = config.pityCharacterId;
+            state.featuredState = config.featuredState;
+            int firstSSR = 0;
+            int target = 0;
+            
+            for (int pulls = 1; pulls <= maxPulls; pulls++) {
+                double uniforms[2];
+                rng.fill(uniforms, 2);
+                GachaResult result = catalog.resolvePull(state, uniforms[0], uniforms[1]);
+                
+                if (firstSSR == 0 && result.rarity == RARITY_SSR) {
+                    firstSSR = pulls;
+                }
+                if (trackTarget && target == 0 && result.characterId == config.targetCharacterId) {
+                    target = pulls;
+                }
+                if (firstSSR != 0 && (!trackTarget || target != 0)) {
+                    break;
+                }
+            }
+            
+            if (firstSSR != 0) {
+                local.pullsToFirstSSR[firstSSR]++;
+            }
+            if (trackTarget) {
+                if (target != 0) {
+                    local.pullsToTarget[target]++;
+                } else {
+                    local.targetNotReached++;
+                }
+            }
+        }
+    }
+
+public:
+    // Katalog harus sudah dikompilasi (GachaSystem::getCatalog() selalu mengembalikan katalog terkompilasi)
+    explicit GachaSimulator(const GachaCatalog& gachaCatalog) : catalog(gachaCatalog) {}
+    
+    // Menjalankan simulasi di semua core; hasil hanya bergantung pada seed, bukan jumlah thread
+    SimulationResult run(const SimulationConfig& config) const {
+        unsigned threadCount = config.threads;
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        
+        uint64_t chunkCount = (config.trials + CHUNK_TRIALS - 1) / CHUNK_TRIALS;
+        if (threadCount > chunkCount) {
+            threadCount = static_cast<unsigned>(std::max<uint64_t>(1, chunkCount));
+        }
+        
+        // Batas tidak boleh di bawah hard pity: setiap trajectory pasti mendapat SSR pertama, sehingga
+        // histogram pullsToFirstSSR selalu berisi config.trials trajectory
+        int maxPulls = std::max(config.maxPullsPerTrial, catalog.getHardPity());
+        size_t histogramSize = static_cast<size_t>(maxPulls) + 1;
+        std::vector<SimulationResult> partials(threadCount);
+        for (SimulationResult& partial : partials) {
+            partial.pullsToFirstSSR.assign(histogramSize, 0);
+            partial.pullsToTarget.assign(histogramSize, 0);
+        }
+        
+        // Setiap thread mengambil potongan berikutnya sampai habis
+        std::atomic<uint64_t> nextChunk(0);
+        auto worker = [&](unsigned index) {
+            for (uint64_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+                runChunk(config, maxPulls, chunk, partials[index]);
+            }
+        };
+        
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threadCount; i++) {
+            workers.emplace_back(worker, i);
+        }
+        worker(0);
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+        
+        // Reduksi: penjumlahan integer sehingga urutan thread tidak berpengaruh
+        SimulationResult result;
+        result.trials = config.trials;
+        result.pullsToFirstSSR.assign(histogramSize, 0);
+        result.pullsToTarget.assign(histogramSize, 0);
+        for (const SimulationResult& partial : partials) {
+            for (size_t i = 0; i < histogramSize; i++) {
+                result.pullsToFirstSSR[i] += partial.pullsToFirstSSR[i];
+                result.pullsToTarget[i] += partial.pullsToTarget[i];
+            }
+            result.targetNotReached += partial.targetNotReached;
+        }
+        return result;
+    }
+};
+
+#endif // GACHA_SIMULATOR_H
@@ -0,0 +1,435 @@
+#ifndef GACHA_SYSTEM_H
+#define GACHA_SYSTEM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_metrics.h"
+#include "gacha_rng.h"
+#include "gacha_types.h"
+#include "pull_history.h"
+#include "pull_log.h"
+#include "snapshot.h"
+
+// Satu pemain lokal: katalog banner, state pity, riwayat dan generator random sendiri
+class GachaSystem {
+private:
+    // Jumlah pull per blok angka random di pullBatch()
+    static constexpr size_t RANDOM_BLOCK = 256;
+    
+    GachaCatalog catalog;
+    PityState state;
+    PullHistory history;
+    GachaRng rng;
+    uint64_t streamPulls;       // Pull sejak seed terakhir = posisi blok di stream Philox
+    PullLog* pullLog;           // Catatan pull opsional (nullptr = tidak dicatat)
+    uint64_t versionRevision;   // Revisi katalog saat catalogVersion dihitung
+    uint16_t catalogVersion;
+    bool versionKnown;
+    
+    // Versi katalog untuk catatan pull; sidiknya dihitung ulang hanya jika katalog berubah
+    uint16_t currentVersion() {
+        if (!versionKnown || versionRevision != catalog.getRevision()) {
+            catalogVersion = catalog.fingerprint();
+            versionRevision = catalog.getRevision();
+            versionKnown = true;
+        }
+        return catalogVersion;
+    }
+    
+    // Menambah count hasil berurutan ke catatan pull; before = state pity sebelum hasil pertama
+    void logResults(const GachaResult* results, size_t count, const PityState& before) {
+        uint16_t version = currentVersion();
+        uint8_t featuredState = before.featuredState;
+        PullLogRecord chunk[RANDOM_BLOCK];
+        for (size_t done = 0; done < count; done += RANDOM_BLOCK) {
+            size_t chunkSize = std::min(RANDOM_BLOCK, count - done);
+            for (size_t i = 0; i < chunkSize; i++) {
+                const GachaResult& result = results[done + i];
+                chunk[i] = makePullLogRecord(rng.getStream(), streamPulls + done + i, result);
+                chunk[i].selectedCharPity = before.selectedCharPity;
+                chunk[i].bannerVersion = version;
+                chunk[i].featuredState = featuredState;
+                if (result.rarity == RARITY_SSR) {
+                    featuredState = catalog.nextFeaturedState(featuredState, result.characterId, before.selectedCharPity);
+                }
+            }
+            pullLog->append(chunk, chunkSize);
+        }
+    }
+
+public:
+    // Konstruktor
+    GachaSystem() : streamPulls(0), pullLog(nullptr), versionRevision(0), catalogVersion(0), versionKnown(false) {
+        state.pullCount = 0;
+        state.selectedCharPity = 0;
+        state.featuredState = 0;
+        
+        // Inisialisasi generator angka random dengan seed acak (bisa diganti lewat seed())
+        std::random_device rd;
+        rng.seed(RNG_XOSHIRO256SS, (static_cast<uint64_t>(rd()) << 32) | rd(), 0);
+    }
+    
+    // Katalog banner yang dipakai (bisa dibagikan ke simulasi, analisis atau server).
+    // Perubahan yang tertunda dikompilasi dulu agar sampler sesuai dengan daftar karakter
+    const GachaCatalog& getCatalog() {
+        catalog.compile();
+        return catalog;
+    }
+    
+    // Mengganti katalog (mis. banner dari file konfigurasi) dengan tetap mempertahankan pity dan riwayat.
+    // ID karakter di riwayat mengacu ke urutan katalog, jadi katalog baru tidak boleh lebih kecil
+    bool setCatalog(const GachaCatalog& gachaCatalog) {
+        if (gachaCatalog.size() < catalog.size()) {
+            return false;
+        }
+        catalog = gachaCatalog;
+        catalog.compile();
+        versionKnown = false;
+        
+        // Counter yang melewati hard pity baru langsung mendapat garansi pada pull berikutnya
+        state.pullCount = std::min(state.pullCount, catalog.getHardPity() - 1);
+        return true;
+    }
+    
+    // Menambahkan karakter baru, mengembalikan ID-nya
+    uint32_t addCharacter(const std::string& name, Rarity rarity, double rate, 
+                    const std::string& title = "", const std::string& element = "") {
+        return catalog.addCharacter(name, rarity, rate, title, element);
+    }
+    
+    // Menambahkan banyak karakter sekaligus
+    void addCharacters(const std::vector<Character>& newCharacters) {
+        catalog.addCharacters(newCharacters);
+    }
+    
+    // Menghapus karakter dari banner (ID tetap berlaku untuk riwayat), false jika tidak aktif
+    bool removeCharacter(uint32_t characterId) {
+        return catalog.removeCharacter(characterId);
+    }
+    
+    // Mengubah rate karakter aktif
+    bool setCharacterRate(uint32_t characterId, double rate) {
+        return catalog.setCharacterRate(characterId, rate);
+    }
+    
+    // Menambahkan karakter baru dengan nama rarity, false jika rarity tidak dikenal
+    bool addCharacter(const std::string& name, const std::string& rarity, double rate, 
+                    const std::string& title = "", const std::string& element = "") {
+        return catalog.addCharacter(name, rarity, rate, title, element);
+    }
+    
+    // Seed ulang generator (engine saat ini) untuk urutan yang bisa diulang; stream = ID pemain di catatan pull
+    void seed(uint64_t seedValue, uint64_t stream = 0) {
+        rng.seed(rng.getKind(), seedValue, stream);
+        streamPulls = 0;
+    }
+    
+    // Mengganti engine random sekaligus seed dan stream-nya
+    void setRng(RngKind kind, uint64_t seedValue, uint64_t stream = 0) {
+        rng.seed(kind, seedValue, stream);
+        streamPulls = 0;
+    }
+    
+    const GachaRng& getRng() const {
+        return rng;
+    }
+    
+    // Jumlah pull sejak seed terakhir (pullIndex pull berikutnya di catatan pull)
+    uint64_t getStreamPosition() const {
+        return streamPulls;
+    }
+    
+    // Mencatat setiap pull berikutnya ke catatan pull sebagai pemain dengan ID stream generator.
+    // Catatan versi 2 harus dibuka dengan engine philox4x32, false (tidak dipasang) jika tidak. Generator dipindah
+    // ke Philox dengan seed catatan di posisi getStreamPosition(), jadi pullIndex melanjutkan dan setiap pull
+    // bisa diulang langsung dari blok-nya; seed ulang sesudahnya membutuhkan catatan baru. nullptr = berhenti mencatat
+    bool setPullLog(PullLog* log) {
+        if (log && log->hasSeed() && log->getRngKind() != RNG_PHILOX4X32) {
+            return false;
+        }
+        if (log && log->hasSeed() && (rng.getKind() != RNG_PHILOX4X32 || rng.getSeed() != log->getSeed())) {
+            rng.seed(RNG_PHILOX4X32, log->getSeed(), rng.getStream());
+            rng.seek(streamPulls);
+        }
+        pullLog = log;
+        return true;
+    }
+    
+    // Mengatur parameter pity
+    bool setPitySettings(int hardPityValue, int softPityValue, double softPityBoostValue) {
+        return catalog.setPitySettings(hardPityValue, softPityValue, softPityBoostValue);
+    }
+    
+    // Mengatur pity dengan kurva soft pity (linear, tabel, atau faktor tetap)
+    bool setPitySettings(int hardPityValue, int softPityValue, const SoftPityCurve& curve) {
+        return catalog.setPitySettings(hardPityValue, softPityValue, curve);
+    }
+    
+    // Set karakter pity
+    void setSelectedCharPity(int index) {
+        if (index >= 0 && catalog.isActive(static_cast<uint32_t>(index))) {
+            state.selectedCharPity = static_cast<uint32_t>(index);
+        }
+    }
+    
+    // Set karakter pity berdasarkan nama
+    bool setSelectedCharPityByName(const std::string& name) {
+        int index = catalog.findSSRCharacter(name);
+        if (index < 0) {
+            return false;
+        }
+        state.selectedCharPity = static_cast<uint32_t>(index);
+        return true;
+    }
+    
+    // Melakukan satu kali pull (tanpa alokasi memori selama riwayat masih muat, lihat reserveHistory())
+    GachaResult pull() {
+        MetricsTimer timer(HISTOGRAM_PULL);
+        double uniforms[2];
+        rng.fill(uniforms, 2);
+        
+        // Perubahan katalog sejak pull terakhir dikompilasi sekali di sini
+        catalog.compile();
+        PityState before = state;
+        GachaResult result = catalog.resolvePull(state, uniforms[0], uniforms[1]);
+        if (pullLog) {
+            logResults(&result, 1, before);
+        }
+        streamPulls++;
+        history.record(result);
+        GachaMetrics::recordResults(&result, 1, catalog.getSoftPityStart());
+        return result;
+    }
+    
+    // Melakukan count pull sekaligus ke buffer milik pemanggil
+    void pullBatch(GachaResult* out, size_t count) {
+        // Angka random dibuat per blok, urutannya sama persis dengan pull() satu per satu
+        double uniforms[2 * RANDOM_BLOCK];
+        catalog.compile();
+        PityState before = state;
+        
+        for (size_t done = 0; done < count; done += RANDOM_BLOCK) {
+            size_t blockSize = std::min(RANDOM_BLOCK, count - done);
+            rng.fill(uniforms, 2 * blockSize);
+            catalog.resolveBatch(state, uniforms, blockSize, out + done);
+        }
+        if (pullLog) {
+            logResults(out, count, before);
+        }
+        streamPulls += count;
+        
+        history.append(out, count);
+        GachaMetrics::recordResults(out, count, catalog.getSoftPityStart());
+    }
+    
+    // Melakukan multiple pull
+    std::vector<GachaResult> multiPull(int count) {
+        MetricsTimer timer(HISTOGRAM_MULTI_PULL);
+        GachaMetrics::add(METRIC_MULTI_PULL_CALLS);
+        std::vector<GachaResult> results(count > 0 ? count : 0);
+        pullBatch(results.data(), results.size());
+        return results;
+    }
+    
+    // Mendapatkan history pull
+    const PullHistory& getHistory() const {
+        return history;
+    }
+    
+    // Membatasi jumlah riwayat yang disimpan (0 = tanpa batas)
+    void setHistoryLimit(size_t limit) {
+        history.setCapacity(limit);
+    }
+    
+    // Menyiapkan riwayat untuk pulls pull berikutnya sekaligus, agar pull() dan pullBatch()
+    // sampai batas itu tidak memanggil allocator sama sekali
+    void reserveHistory(size_t pulls) {
+        history.reserve(history.size() + pulls, catalog.size());
+    }
+    
+    // Menyimpan katalog, state pity dan riwayat ke file snapshot
+    bool saveSnapshot(const std::string& path) const {
+        SnapshotWriter writer;
+        catalog.writeTo(writer);
+        
+        // Posisi stream disimpan agar pullIndex catatan pull melanjutkan setelah snapshot dimuat
+        uint64_t pullIndex = streamPulls;
+        PlayerColumns player;
+        player.count = 1;
+        player.seed = rng.getSeed();
+        player.pullCounts = &state.pullCount;
+        player.selectedCharPity = &state.selectedCharPity;
+        player.pullIndices = &pullIndex;
+        player.featuredStates = &state.featuredState;
+        player.writeTo(writer);
+        
+        history.writeTo(writer);
+        return writer.writeFile(path);
+    }
+    
+    // Menambahkan seluruh riwayat yang disimpan ke file catatan pull sebagai pemain playerId
+    // (riwayat beberapa pemain bisa dikumpulkan di satu file untuk dianalisis bersama).
+    // Riwayat tidak menyimpan kolom audit, jadi header-nya ber-seed 0 dan hasilnya hanya untuk analisis;
+    // catatan yang bisa diverifikasi ulang dibuat lewat setPullLog()
+    bool exportHistory(const std::string& path, uint64_t playerId = 0) const {
+        PullLog log;
+        if (!log.open(path, 0)) {
+            return false;
+        }
+        PullLogRecord chunk[256];
+        for (size_t first = 0; first < history.size(); first += 256) {
+            size_t count = std::min<size_t>(256, history.size() - first);
+            history.exportRecords(first, count, playerId, chunk);
+            if (!log.append(chunk, count)) {
+                return false;
+            }
+        }
+        return log.flush();
+    }
+    
+    // Memuat snapshot dari saveSnapshot(), false (tanpa perubahan) jika file tidak ada atau tidak valid.
+    // Engine dan seed generator tidak ikut dimuat; posisi stream (getStreamPosition()) dipulihkan dan
+    // generator Philox dipindah ke blok itu, jadi catatan pull yang dipasang lagi tetap menyambung
+    bool loadSnapshot(const std::string& path) {
+        SnapshotFile file;
+        SnapshotReader catalogReader(nullptr, 0, 0);
+        SnapshotReader playerReader(nullptr, 0, 0);
+        SnapshotReader historyReader(nullptr, 0, 0);
+        if (!file.open(path) || !file.findSection(SECTION_CATALOG, catalogReader) ||
+            !file.findSection(SECTION_PLAYERS, playerReader) || !file.findSection(SECTION_HISTORY, historyReader)) {
+            return false;
+        }
+        
+        GachaCatalog loadedCatalog;
+        PlayerColumns player;
+        PullHistory loadedHistory;
+        if (!loadedCatalog.readFrom(catalogReader) || !player.readFrom(playerReader, loadedCatalog) ||
+            player.count != 1 || !loadedHistory.readFrom(historyReader)) {
+            return false;
+        }
+        
+        catalog = loadedCatalog;
+        versionKnown = false;
+        state.pullCount = player.pullCounts[0];
+        state.selectedCharPity = player.selectedCharPity[0];
+        state.featuredState = player.featuredStateOf(0, 0);
+        streamPulls = player.pullIndices[0];
+        rng.seek(streamPulls);
+        history = std::move(loadedHistory);
+        return true;
+    }
+    
+    // Mendapatkan parameter pity
+    int getHardPity() const {
+        return catalog.getHardPity();
+    }
+    
+    int getSoftPityStart() const {
+        return catalog.getSoftPityStart();
+    }
+    
+    double getSoftPityBoost() const {
+        return catalog.getSoftPityBoost();
+    }
+    
+    int getSelectedCharPity() const {
+        return static_cast<int>(state.selectedCharPity);
+    }
+    
+    // State pity pemain saat ini
+    const PityState& getPityState() const {
+        return state;
+    }
+    
+    // State rate-up pemain saat ini, nullptr jika banner tanpa rate-up
+    const FeaturedState* getFeaturedState() const {
+        const std::vector<FeaturedState>& states = catalog.getFeaturedStates();
+        if (states.empty()) {
+            return nullptr;
+        }
+        return &states[state.featuredState < states.size() ? state.featuredState : 0];
+    }
+    
+    // Jumlah pull sejak SSR terakhir
+    int getPullCount() const {
+        return state.pullCount;
+    }
+    
+    // Mendapatkan berapa pull lagi sampai garansi
+    int getPityCounter() const {
+        return catalog.getHardPity() - state.pullCount;
+    }
+    
+    // Mendapatkan informasi soft pity
+    int getSoftPityCounter() const {
+        return catalog.getSoftPityStart() - state.pullCount;
+    }
+    
+    // Cek apakah dalam kondisi soft pity
+    bool isInSoftPity() const {
+        return state.pullCount >= catalog.getSoftPityStart() && state.pullCount < catalog.getHardPity();
+    }
+    
+    // Mendapatkan karakter yang akan didapat saat pity
+    std::string getSelectedPityCharName() const {
+        if (state.selectedCharPity < catalog.size()) {
+            return catalog.getName(state.selectedCharPity);
+        }
+        return "Unknown";
+    }
+    
+    // Mendapatkan nama item dari hasil pull
+    std::string getItemName(const GachaResult& result) const {
+        return catalog.getItemName(result);
+    }
+    
+    // ID karakter aktif berdasarkan rarity (view ke katalog, berlaku sampai katalog diubah)
+    std::span<const uint32_t> getCharactersByRarity(Rarity rarity) const {
+        return catalog.getCharactersByRarity(rarity);
+    }
+    
+    // ID karakter SSR aktif
+    std::span<const uint32_t> getSSRCharacters() const {
+        return catalog.getCharactersByRarity(RARITY_SSR);
+    }
+    
+    // Mendapatkan rate berdasarkan rarity
+    double getRarityRate(Rarity rarity) const {
+        return catalog.getRarityRate(rarity);
+    }
+    
+    // Peluang SSR pull berikutnya (dengan soft pity), dari tabel batas yang sama dengan pull
+    double getCurrentSSRRate() const {
+        return catalog.getThresholdsAt(state.pullCount + 1).ssr;
+    }
+    
+    // Menghitung jumlah karakter berdasarkan rarity yang didapat (dari counter, O(karakter))
+    std::map<std::string, std::map<std::string, uint64_t>> countCharactersByRarity() const {
+        std::map<std::string, std::map<std::string, uint64_t>> counts;
+        for (uint32_t i = 0; i < catalog.size(); i++) {
+            uint64_t count = history.getCharacterCount(i);
+            if (count > 0) {
+                counts[rarityName(catalog.getRarity(i))][catalog.getName(i)] += count;
+            }
+        }
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            Rarity rarity = static_cast<Rarity>(i);
+            uint64_t count = history.getNoCharacterCount(rarity);
+            if (count > 0) {
+                counts[rarityName(rarity)][std::string(rarityName(rarity)) + " Item"] += count;
+            }
+        }
+        return counts;
+    }
+};
+
+#endif // GACHA_SYSTEM_H
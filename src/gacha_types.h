@@ -0,0 +1,68 @@
+#ifndef GACHA_TYPES_H
+#define GACHA_TYPES_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Enumerasi rarity (ID kecil, dipakai di jalur pull menggantikan string)
+enum Rarity : uint8_t {
+    RARITY_SSR = 0,
+    RARITY_SR = 1,
+    RARITY_R = 2,
+    RARITY_COMMON = 3,
+    RARITY_COUNT = 4
+};
+
+// ID karakter untuk pull yang tidak menghasilkan karakter (contoh: "Common Item")
+const uint32_t NO_CHARACTER = 0xFFFFFFFFu;
+
+// Batas hard pity (nomor pull disimpan 16-bit di riwayat)
+const int MAX_HARD_PITY = 65535;
+
+// Nama rarity untuk tampilan
+inline const char* rarityName(Rarity rarity) {
+    static const char* const names[RARITY_COUNT] = { "SSR", "SR", "R", "Common" };
+    return rarity < RARITY_COUNT ? names[rarity] : "Unknown";
+}
+
+// Mengubah nama rarity menjadi ID, false jika nama tidak dikenal
+inline bool parseRarity(const std::string& name, Rarity& rarity) {
+    for (int i = 0; i < RARITY_COUNT; i++) {
+        if (name == rarityName(static_cast<Rarity>(i))) {
+            rarity = static_cast<Rarity>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Struktur untuk menyimpan hasil pull (POD kecil, nama di-resolve saat ditampilkan)
+struct GachaResult {
+    uint32_t characterId; // Indeks karakter di katalog, atau NO_CHARACTER
+    Rarity rarity;
+    bool isPity;
+    uint8_t bannerId;     // Banner asal di registry (0 untuk sistem satu banner)
+    int32_t pullNumber;
+};
+
+static_assert(std::is_trivially_copyable<GachaResult>::value, "GachaResult harus POD");
+static_assert(sizeof(GachaResult) <= 12, "GachaResult harus tetap kecil");
+
+// Flag ringkas hasil pull untuk riwayat dan file: bit 0-6 rarity, bit 7 pity
+const uint8_t PITY_FLAG = 0x80;
+
+inline uint8_t packResultFlags(const GachaResult& result) {
+    return static_cast<uint8_t>(result.rarity) | (result.isPity ? PITY_FLAG : 0);
+}
+
+// Struktur untuk karakter
+struct Character {
+    std::string name;
+    Rarity rarity; // SSR, SR, R, Common
+    double rate;
+    std::string title;
+    std::string element; // Elemen karakter (baru)
+};
+
+#endif // GACHA_TYPES_H
@@ -0,0 +1,248 @@
+#ifndef GACHA_PITY_ANALYZER_H
+#define GACHA_PITY_ANALYZER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_types.h"
+
+// Distribusi peluang eksak jumlah pull sampai SSR berikutnya
+struct PityDistribution {
+    std::vector<double> pmf;  // pmf[n] = peluang SSR pertama tepat pada pull ke-n
+    
+    // Nilai harapan jumlah pull
+    double expected() const {
+        double sum = 0.0;
+        for (size_t pulls = 0; pulls < pmf.size(); pulls++) {
+            sum += pulls * pmf[pulls];
+        }
+        return sum;
+    }
+    
+    // Peluang SSR didapat dalam maksimal n pull
+    double cdf(int pulls) const {
+        double sum = 0.0;
+        for (size_t i = 0; i < pmf.size() && static_cast<int>(i) <= pulls; i++) {
+            sum += pmf[i];
+        }
+        return sum;
+    }
+    
+    // Jumlah pull terkecil dengan peluang kumulatif >= p
+    int percentile(double p) const {
+        double sum = 0.0;
+        for (size_t pulls = 0; pulls < pmf.size(); pulls++) {
+            sum += pmf[pulls];
+            if (sum >= p) {
+                return static_cast<int>(pulls);
+            }
+        }
+        return static_cast<int>(pmf.size()) - 1;
+    }
+};
+
+// Analisis eksak rantai Markov pity (tanpa sampling) dari sebuah katalog banner
+class PityAnalyzer {
+private:
+    // Batas peluang di mana ekor distribusi dianggap habis saat konvolusi
+    static constexpr double NEGLIGIBLE_MASS = 1e-18;
+    
+    const GachaCatalog& catalog;
+    
+    // Konvolusi a * b, dipotong sampai panjang maxLength
+    static std::vector<double> convolve(const std::vector<double>& a, const std::vector<double>& b, size_t maxLength) {
+        std::vector<double> result(std::min(maxLength, a.size() + b.size() - 1), 0.0);
+        for (size_t i = 0; i < a.size() && i < result.size(); i++) {
+            if (a[i] == 0.0) {
+                continue;
+            }
+            for (size_t j = 0; j < b.size() && i + j < result.size(); j++) {
+                result[i + j] += a[i] * b[j];
+            }
+        }
+        return result;
+    }
+    
+    // Bobot karakter di dalam pool-nya (0 jika bukan anggota)
+    static double poolShare(const RaritySampler& pool, uint32_t characterId) {
+        double total = 0.0;
+        double weight = 0.0;
+        for (size_t i = 0; i < pool.members.size(); i++) {
+            total += pool.weights[i];
+            if (pool.members[i] == characterId) {
+                weight = pool.weights[i];
+            }
+        }
+        return total > 0.0 ? weight / total : 0.0;
+    }
+    
+    // Peluang satu SSR di state rate-up state memberi target; peluang tidak mendapat target ditambahkan
+    // ke miss[state berikutnya]. Cabangnya sama dengan pickFeatured() di katalog
+    double targetChance(uint8_t state, uint32_t target, uint32_t selected, bool hardPity, std::vector<double>& miss) const {
+        const std::vector<FeaturedState>& states = catalog.getFeaturedStates();
+        if (states.empty()) {
+            // Banner biasa: hard pity memberi karakter pity jika masih aktif, selain itu undian SSR biasa
+            double hit;
+            if (hardPity && catalog.isActive(selected)) {
+                hit = selected == target ? 1.0 : 0.0;
+            } else {
+                double total = catalog.getCharacterRateTotal(RARITY_SSR);
+                hit = catalog.isActive(target) && catalog.getRarity(target) == RARITY_SSR && total > 0.0 ?
+                    catalog.getRate(target) / total : 0.0;
+            }
+            miss[0] += 1.0 - hit;
+            return hit;
+        }
+        
+        const FeaturedState& current = states[state];
+        if (current.forceTarget && catalog.isFeatured(selected)) {
+            if (selected == target) {
+                return 1.0;
+            }
+            miss[current.next[FEATURED_TARGET]] += 1.0;
+            return 0.0;
+        }
+        
+        double chance = catalog.getStandardPool().members.empty() ? 1.0 : current.featuredChance;
+        double selectedChance = chance * poolShare(catalog.getFeaturedPool(), selected);
+        double featuredHit = chance * poolShare(catalog.getFeaturedPool(), target);
+        double standardHit = (1.0 - chance) * poolShare(catalog.getStandardPool(), target);
+        bool targetIsSelected = target == selected;
+        miss[current.next[FEATURED_TARGET]] += selectedChance - (targetIsSelected ? featuredHit : 0.0);
+        miss[current.next[FEATURED_WIN]] += chance - selectedChance - (targetIsSelected ? 0.0 : featuredHit);
+        miss[current.next[FEATURED_LOSE]] += 1.0 - chance - standardHit;
+        return featuredHit + standardHit;
+    }
+
+public:
+    explicit PityAnalyzer(const GachaCatalog& gachaCatalog) : catalog(gachaCatalog) {}
+    
+    // Peluang SSR pada pull dengan nilai counter tertentu (setelah ditambah 1)
+    double ssrChanceAt(int counter) const {
+        // Tabel yang sama dengan resolvePull(): SSR jika angka random < batas SSR, baris hard pity = 1
+        return catalog.getThresholdsAt(counter).ssr;
+    }
+    
+    // Distribusi pull sampai SSR berikutnya, mulai dari counter pity tertentu
+    PityDistribution pullsToSSR(int startCounter = 0) const {
+        PityDistribution distribution;
+        distribution.pmf.push_back(0.0);
+        
+        double survival = 1.0;
+        for (int counter = startCounter + 1; ; counter++) {
+            double chance = ssrChanceAt(counter);
+            distribution.pmf.push_back(survival * chance);
+            survival *= 1.0 - chance;
+            if (chance >= 1.0) {
+                break;
+            }
+        }
+        return distribution;
+    }
+    
+    // Distribusi jumlah SSR dalam N pull: result[k] = peluang tepat k SSR
+    std::vector<double> ssrCountDistribution(int pulls, int startCounter = 0) const {
+        size_t length = static_cast<size_t>(pulls) + 1;
+        std::vector<double> renewal = pullsToSSR(0).pmf;
+        
+        // waiting = distribusi pull sampai SSR ke-k (T_k), dipotong di N
+        std::vector<double> waiting = pullsToSSR(startCounter).pmf;
+        waiting.resize(std::min(waiting.size(), length));
+        
+        // P(jumlah SSR >= k) = P(T_k <= N)
+        std::vector<double> atLeast(1, 1.0);
+        for (int k = 1; k <= pulls; k++) {
+            double mass = 0.0;
+            for (double value : waiting) {
+                mass += value;
+            }
+            atLeast.push_back(mass);
+            if (mass < NEGLIGIBLE_MASS) {
+                break;
+            }
+            waiting = convolve(waiting, renewal, length);
+        }
+        atLeast.push_back(0.0);
+        
+        std::vector<double> counts(atLeast.size() - 1);
+        for (size_t k = 0; k + 1 < atLeast.size(); k++) {
+            counts[k] = atLeast[k] - atLeast[k + 1];
+        }
+        return counts;
+    }
+    
+    // Distribusi pull sampai karakter target didapat, untuk pemain dengan karakter pilihan selected
+    // yang mulai dari counter pity dan state rate-up tertentu. Banner rate-up memakai tabel state yang
+    // sama dengan pull. Dipotong di maxPulls; sisa peluang = target belum didapat sampai batas itu
+    PityDistribution pullsToTarget(uint32_t target, uint32_t selected, int startCounter = 0,
+                                   uint8_t featuredState = 0, int maxPulls = 2000) const {
+        size_t length = static_cast<size_t>(maxPulls) + 1;
+        size_t stateCount = std::max<size_t>(1, catalog.getFeaturedStates().size());
+        if (featuredState >= stateCount) {
+            featuredState = 0;
+        }
+        
+        // Waktu tunggu SSR dipisah menjadi SSR biasa dan hard pity (entri terakhir) karena
+        // banner tanpa rate-up memperlakukan keduanya berbeda
+        std::vector<double> waits[2][2];
+        for (int first = 0; first < 2; first++) {
+            std::vector<double>& organic = waits[first][0];
+            std::vector<double>& pity = waits[first][1];
+            organic = pullsToSSR(first ? startCounter : 0).pmf;
+            pity.assign(organic.size(), 0.0);
+            std::swap(pity.back(), organic.back());
+        }
+        
+        PityDistribution distribution;
+        distribution.pmf.assign(length, 0.0);
+        
+        // starts[s] = peluang SSR sebelumnya (target belum didapat) selesai pada pull ke-n dengan state s
+        std::vector<std::vector<double>> starts(stateCount);
+        starts[featuredState].assign(1, 1.0);
+        std::vector<double> missOrganic(stateCount);
+        std::vector<double> missPity(stateCount);
+        for (int first = 1; ; first = 0) {
+            std::vector<std::vector<double>> next(stateCount);
+            for (size_t state = 0; state < stateCount; state++) {
+                if (starts[state].empty()) {
+                    continue;
+                }
+                std::vector<double> organic = convolve(starts[state], waits[first][0], length);
+                std::vector<double> pity = convolve(starts[state], waits[first][1], length);
+                std::fill(missOrganic.begin(), missOrganic.end(), 0.0);
+                std::fill(missPity.begin(), missPity.end(), 0.0);
+                double hitOrganic = targetChance(static_cast<uint8_t>(state), target, selected, false, missOrganic);
+                double hitPity = targetChance(static_cast<uint8_t>(state), target, selected, true, missPity);
+                
+                for (size_t pulls = 0; pulls < organic.size(); pulls++) {
+                    distribution.pmf[pulls] += hitOrganic * organic[pulls] + hitPity * pity[pulls];
+                }
+                for (size_t to = 0; to < stateCount; to++) {
+                    if (missOrganic[to] <= 0.0 && missPity[to] <= 0.0) {
+                        continue;
+                    }
+                    next[to].resize(std::max(next[to].size(), organic.size()), 0.0);
+                    for (size_t pulls = 0; pulls < organic.size(); pulls++) {
+                        next[to][pulls] += missOrganic[to] * organic[pulls] + missPity[to] * pity[pulls];
+                    }
+                }
+            }
+            
+            double remaining = 0.0;
+            for (const std::vector<double>& pmf : next) {
+                for (double value : pmf) {
+                    remaining += value;
+                }
+            }
+            if (remaining < NEGLIGIBLE_MASS) {
+                break;
+            }
+            starts.swap(next);
+        }
+        return distribution;
+    }
+};
+
+#endif // GACHA_PITY_ANALYZER_H
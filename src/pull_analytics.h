@@ -0,0 +1,379 @@
+#ifndef GACHA_PULL_ANALYTICS_H
+#define GACHA_PULL_ANALYTICS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_types.h"
+#include "pull_history.h"
+#include "pull_log.h"
+#include "snapshot.h"
+
+// Peluang statistik chi-square >= statistic dengan derajat bebas degrees (fungsi gamma tak lengkap Q)
+inline double chiSquarePValue(double statistic, int degrees) {
+    if (degrees <= 0 || statistic <= 0.0) {
+        return 1.0;
+    }
+    double a = degrees / 2.0;
+    double x = statistic / 2.0;
+    double prefix = std::exp(a * std::log(x) - x - std::lgamma(a));
+    
+    // Deret untuk P(a, x) saat x kecil, pecahan berlanjut (Lentz) untuk Q(a, x) selain itu
+    if (x < a + 1.0) {
+        double term = 1.0 / a;
+        double sum = term;
+        for (int n = 1; n < 1000 && term > sum * 1e-15; n++) {
+            term *= x / (a + n);
+            sum += term;
+        }
+        return std::max(0.0, 1.0 - sum * prefix);
+    }
+    const double tiny = 1e-300;
+    double b = x + 1.0 - a;
+    double c = 1.0 / tiny;
+    double d = 1.0 / b;
+    double h = d;
+    for (int n = 1; n < 1000; n++) {
+        double an = -n * (n - a);
+        b += 2.0;
+        d = an * d + b;
+        d = std::fabs(d) < tiny ? tiny : d;
+        c = b + an / c;
+        c = std::fabs(c) < tiny ? tiny : c;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) < 1e-15) {
+            break;
+        }
+    }
+    return prefix * h;
+}
+
+// Hasil uji goodness of fit chi-square
+struct ChiSquareTest {
+    double statistic;
+    int degrees;        // 0 = tidak bisa diuji (kurang dari dua kategori dengan harapan > 0)
+    double pValue;
+    uint64_t samples;
+};
+
+// Statistik satu pass atas record catatan pull. Ukurannya hanya bergantung pada katalog
+// (counter per karakter dan per nilai counter pity), bukan jumlah record. Semua isinya integer
+// sehingga hasil gabungan beberapa thread sama persis dengan satu thread
+struct PullLogStats {
+    uint64_t records;                           // Record yang dihitung
+    uint64_t skipped;                           // Banner lain, atau ID/rarity/counter di luar katalog
+    uint64_t pityPulls;                         // SSR dari hard pity
+    std::vector<uint64_t> characterCounts;      // Per ID karakter
+    std::vector<uint64_t> pityCharacterCounts;  // Per ID karakter, hanya pull hard pity
+    uint64_t itemCounts[RARITY_COUNT];          // Pull tanpa karakter
+    std::vector<uint64_t> counterRarity;        // [counter * RARITY_COUNT + rarity], counter = pull ke-n sejak SSR
+    
+    PullLogStats() : records(0), skipped(0), pityPulls(0) {
+        std::fill(itemCounts, itemCounts + RARITY_COUNT, 0);
+    }
+    
+    // Counter untuk characterCount karakter dan counter pity 1..hardPity
+    PullLogStats(size_t characterCount, int hardPity) : PullLogStats() {
+        characterCounts.assign(characterCount, 0);
+        pityCharacterCounts.assign(characterCount, 0);
+        counterRarity.assign(static_cast<size_t>(hardPity + 1) * RARITY_COUNT, 0);
+    }
+    
+    // Menambahkan statistik lain dengan ukuran katalog yang sama
+    void merge(const PullLogStats& other) {
+        records += other.records;
+        skipped += other.skipped;
+        pityPulls += other.pityPulls;
+        for (size_t i = 0; i < characterCounts.size(); i++) {
+            characterCounts[i] += other.characterCounts[i];
+            pityCharacterCounts[i] += other.pityCharacterCounts[i];
+        }
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            itemCounts[i] += other.itemCounts[i];
+        }
+        for (size_t i = 0; i < counterRarity.size(); i++) {
+            counterRarity[i] += other.counterRarity[i];
+        }
+    }
+    
+    int hardPity() const {
+        return static_cast<int>(counterRarity.size() / RARITY_COUNT) - 1;
+    }
+    
+    // Jumlah pull rarity ini yang terjadi pada pull ke-counter sejak SSR terakhir
+    uint64_t countAt(int counter, Rarity rarity) const {
+        return counterRarity[static_cast<size_t>(counter) * RARITY_COUNT + rarity];
+    }
+    
+    uint64_t rarityCount(Rarity rarity) const {
+        uint64_t total = 0;
+        for (int counter = 1; counter <= hardPity(); counter++) {
+            total += countAt(counter, rarity);
+        }
+        return total;
+    }
+    
+    // Jumlah SSR yang didapat tepat setelah pulls pull tanpa SSR sebelumnya (histogram panjang kekeringan)
+    uint64_t droughtCount(int pulls) const {
+        return pulls >= 1 && pulls <= hardPity() ? countAt(pulls, RARITY_SSR) : 0;
+    }
+    
+    // Rata-rata pull per SSR (termasuk pull SSR-nya)
+    double meanPullsToSSR() const {
+        uint64_t count = 0;
+        double sum = 0.0;
+        for (int pulls = 1; pulls <= hardPity(); pulls++) {
+            count += droughtCount(pulls);
+            sum += static_cast<double>(pulls) * droughtCount(pulls);
+        }
+        return count > 0 ? sum / count : 0.0;
+    }
+    
+    // Kekeringan SSR terpanjang yang pernah berakhir dengan SSR
+    int longestDrought() const {
+        for (int pulls = hardPity(); pulls >= 1; pulls--) {
+            if (droughtCount(pulls) > 0) {
+                return pulls;
+            }
+        }
+        return 0;
+    }
+};
+
+// Analitik catatan pull terhadap satu katalog: frekuensi per karakter, kecocokan dengan rate
+// yang dikonfigurasi, statistik pity dan panjang kekeringan SSR. Record dibaca per potongan
+// (dari file yang dipetakan, stream, atau riwayat pemain) dan dibagi ke semua core
+class PullLogAnalyzer {
+private:
+    // Record per potongan kerja (dan per pembacaan stream)
+    static constexpr size_t CHUNK_RECORDS = 1 << 16;
+    
+    const GachaCatalog& catalog;
+    int bannerFilter;
+
+public:
+    // bannerId >= 0: hanya record dari banner itu yang dihitung (catatan server multi-banner)
+    explicit PullLogAnalyzer(const GachaCatalog& gachaCatalog, int bannerId = -1) :
+        catalog(gachaCatalog),
+        bannerFilter(bannerId) {}
+    
+    PullLogStats makeStats() const {
+        return PullLogStats(catalog.size(), catalog.getHardPity());
+    }
+    
+    // Menambahkan count record ke stats (satu pass, tanpa alokasi)
+    void add(const PullLogRecord* records, size_t count, PullLogStats& stats) const {
+        size_t characterCount = stats.characterCounts.size();
+        int hardPity = stats.hardPity();
+        for (size_t i = 0; i < count; i++) {
+            const PullLogRecord& record = records[i];
+            unsigned rarity = record.flags & ~PITY_FLAG;
+            bool isPity = (record.flags & PITY_FLAG) != 0;
+            if ((bannerFilter >= 0 && record.bannerId != bannerFilter) || rarity >= RARITY_COUNT ||
+                record.pullNumber < 1 || record.pullNumber > hardPity ||
+                (record.characterId >= characterCount && record.characterId != NO_CHARACTER)) {
+                stats.skipped++;
+                continue;
+            }
+            
+            stats.records++;
+            if (record.characterId == NO_CHARACTER) {
+                stats.itemCounts[rarity]++;
+            } else {
+                stats.characterCounts[record.characterId]++;
+                if (isPity) {
+                    stats.pityCharacterCounts[record.characterId]++;
+                }
+            }
+            if (isPity) {
+                stats.pityPulls++;
+            }
+            stats.counterRarity[static_cast<size_t>(record.pullNumber) * RARITY_COUNT + rarity]++;
+        }
+    }
+    
+    // Menganalisis record di memori (mis. file yang dipetakan) dengan threads thread (0 = semua core)
+    PullLogStats analyze(const PullLogRecord* records, size_t count, unsigned threads = 0) const {
+        size_t chunkCount = (count + CHUNK_RECORDS - 1) / CHUNK_RECORDS;
+        unsigned threadCount = threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+        threadCount = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threadCount, chunkCount)));
+        
+        std::vector<PullLogStats> partials(threadCount, makeStats());
+        std::atomic<size_t> nextChunk(0);
+        auto worker = [&](unsigned index) {
+            for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+                size_t first = chunk * CHUNK_RECORDS;
+                add(records + first, std::min(CHUNK_RECORDS, count - first), partials[index]);
+            }
+        };
+        
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threadCount; i++) {
+            workers.emplace_back(worker, i);
+        }
+        worker(0);
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+        
+        for (unsigned i = 1; i < threadCount; i++) {
+            partials[0].merge(partials[i]);
+        }
+        return partials[0];
+    }
+    
+    // Memetakan file catatan pull lalu menganalisisnya, false jika file tidak ada atau header-nya salah
+    bool analyzeFile(const std::string& path, PullLogStats& stats, unsigned threads = 0) const {
+        MappedFile mapped;
+        const PullLogRecord* records = nullptr;
+        size_t count = 0;
+        std::vector<PullLogRecord> converted;
+        if (!mapped.open(path) || !PullLog::records(mapped, records, count, converted)) {
+            return false;
+        }
+        stats = analyze(records, count, threads);
+        return true;
+    }
+    
+    // Membaca catatan pull dari stream (mis. pipe) per potongan dengan memori tetap
+    bool analyzeStream(FILE* file, PullLogStats& stats) const {
+        // Header versi 1 lebih pendek, jadi bagian bersama dibaca dulu
+        char header[PullLog::HEADER_SIZE];
+        if (std::fread(header, 1, PullLog::V1_HEADER_SIZE, file) != PullLog::V1_HEADER_SIZE) {
+            return false;
+        }
+        uint32_t version = PullLog::versionOf(header, PullLog::HEADER_SIZE);
+        size_t rest = PullLog::headerSize(version) - PullLog::V1_HEADER_SIZE;
+        if (version == 0 || std::fread(header + PullLog::V1_HEADER_SIZE, 1, rest, file) != rest) {
+            return false;
+        }
+        
+        stats = makeStats();
+        std::vector<PullLogRecord> chunk(CHUNK_RECORDS);
+        size_t read = 0;
+        if (version == PullLog::VERSION) {
+            while ((read = std::fread(chunk.data(), sizeof(PullLogRecord), chunk.size(), file)) > 0) {
+                add(chunk.data(), read, stats);
+            }
+            return std::ferror(file) == 0;
+        }
+        std::vector<char> raw(CHUNK_RECORDS * PullLog::V1_RECORD_SIZE);
+        while ((read = std::fread(raw.data(), PullLog::V1_RECORD_SIZE, CHUNK_RECORDS, file)) > 0) {
+            for (size_t i = 0; i < read; i++) {
+                chunk[i] = PullLog::fromV1(raw.data() + i * PullLog::V1_RECORD_SIZE);
+            }
+            add(chunk.data(), read, stats);
+        }
+        return std::ferror(file) == 0;
+    }
+    
+    // Seluruh riwayat yang disimpan satu pemain, per potongan tanpa menyalin riwayatnya
+    PullLogStats analyzeHistory(const PullHistory& history) const {
+        PullLogStats stats = makeStats();
+        PullLogRecord chunk[256];
+        for (size_t first = 0; first < history.size(); first += 256) {
+            size_t count = std::min<size_t>(256, history.size() - first);
+            history.exportRecords(first, count, 0, chunk);
+            add(chunk, count, stats);
+        }
+        return stats;
+    }
+    
+    // Kecocokan jumlah per rarity dengan peluang katalog. Harapan tiap pull diambil dari tabel batas
+    // pada counter pity-nya (baris hard pity = SSR pasti), jadi soft pity dan hard pity ikut diperhitungkan
+    ChiSquareTest rarityFit(const PullLogStats& stats) const {
+        double expected[RARITY_COUNT] = { 0.0, 0.0, 0.0, 0.0 };
+        uint64_t observed[RARITY_COUNT] = { 0, 0, 0, 0 };
+        for (int counter = 1; counter <= stats.hardPity(); counter++) {
+            uint64_t total = 0;
+            for (int i = 0; i < RARITY_COUNT; i++) {
+                total += stats.countAt(counter, static_cast<Rarity>(i));
+                observed[i] += stats.countAt(counter, static_cast<Rarity>(i));
+            }
+            const RarityThresholds& threshold = catalog.getThresholdsAt(counter);
+            double chances[RARITY_COUNT] = {
+                threshold.ssr, threshold.sr - threshold.ssr, threshold.r - threshold.sr, 1.0 - threshold.r
+            };
+            for (int i = 0; i < RARITY_COUNT; i++) {
+                expected[i] += total * chances[i];
+            }
+        }
+        return chiSquare(observed, expected, RARITY_COUNT);
+    }
+    
+    // Kecocokan pembagian karakter di dalam satu rarity dengan bobot rate-nya (pull hard pity tidak dihitung).
+    // SSR di banner rate-up mengikuti 50/50, bukan bobot rate, sehingga tidak diuji (degrees = 0)
+    ChiSquareTest characterFit(const PullLogStats& stats, Rarity rarity) const {
+        std::vector<uint64_t> observed;
+        std::vector<double> weights;
+        double totalWeight = 0.0;
+        uint64_t samples = 0;
+        if (rarity != RARITY_SSR || !catalog.hasFeatured()) {
+            std::span<const uint32_t> members = catalog.getCharactersByRarity(rarity);
+            std::span<const double> rates = catalog.getRatesByRarity(rarity);
+            for (size_t i = 0; i < members.size(); i++) {
+                if (members[i] >= stats.characterCounts.size()) {
+                    continue;
+                }
+                uint64_t count = stats.characterCounts[members[i]] - stats.pityCharacterCounts[members[i]];
+                observed.push_back(count);
+                weights.push_back(rates[i]);
+                totalWeight += rates[i];
+                samples += count;
+            }
+        }
+        
+        std::vector<double> expected(weights.size(), 0.0);
+        for (size_t i = 0; i < weights.size() && totalWeight > 0.0; i++) {
+            expected[i] = samples * weights[i] / totalWeight;
+        }
+        return chiSquare(observed.data(), expected.data(), observed.size());
+    }
+    
+    // Peluang SSR yang didapat setelah soft pity dimulai (counter dengan peluang SSR di atas rate dasar)
+    double softPitySSRShare(const PullLogStats& stats) const {
+        uint64_t softPity = 0;
+        uint64_t total = 0;
+        double baseRate = catalog.getThresholdsAt(1).ssr;
+        for (int counter = 1; counter <= stats.hardPity(); counter++) {
+            uint64_t count = stats.countAt(counter, RARITY_SSR);
+            total += count;
+            if (catalog.getThresholdsAt(counter).ssr > baseRate) {
+                softPity += count;
+            }
+        }
+        return total > 0 ? static_cast<double>(softPity) / total : 0.0;
+    }
+    
+    // Statistik chi-square dari jumlah teramati dan harapan; kategori dengan harapan 0 dilewati
+    static ChiSquareTest chiSquare(const uint64_t* observed, const double* expected, size_t count) {
+        ChiSquareTest test;
+        test.statistic = 0.0;
+        test.degrees = -1;
+        test.samples = 0;
+        for (size_t i = 0; i < count; i++) {
+            test.samples += observed[i];
+            if (expected[i] > 0.0) {
+                double difference = observed[i] - expected[i];
+                test.statistic += difference * difference / expected[i];
+                test.degrees++;
+            }
+        }
+        test.degrees = std::max(test.degrees, 0);
+        test.pValue = chiSquarePValue(test.statistic, test.degrees);
+        return test;
+    }
+};
+
+#endif // GACHA_PULL_ANALYTICS_H
@@ -0,0 +1,299 @@
+#include "pull_audit.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "gacha_rng.h"
+#include "snapshot.h"
+
+namespace {
+
+// State jalur pity pemain setelah record terakhirnya
+struct TrackAudit {
+    int32_t pullCount;
+    uint8_t featuredState;
+};
+
+void addIssue(AuditReport& report, size_t limit, uint64_t position, const PullLogRecord& record, AuditIssue issue,
+              const GachaResult* expected) {
+    report.issueCounts[issue]++;
+    if (report.divergences.size() < limit) {
+        AuditDivergence divergence;
+        divergence.record = position;
+        divergence.playerId = record.playerId;
+        divergence.pullIndex = record.pullIndex;
+        divergence.issue = issue;
+        divergence.expected = expected ? *expected : GachaResult();
+        report.divergences.push_back(divergence);
+    }
+}
+
+}  // namespace
+
+const char* auditIssueName(AuditIssue issue) {
+    static const char* const names[AUDIT_ISSUE_COUNT] = {
+        "result", "unknown_banner", "invalid_state", "sequence", "pity_chain"
+    };
+    return issue < AUDIT_ISSUE_COUNT ? names[issue] : "unknown";
+}
+
+AuditReport::AuditReport() : records(0), players(0) {
+    std::fill(issueCounts, issueCounts + AUDIT_ISSUE_COUNT, 0);
+}
+
+uint64_t AuditReport::divergenceCount() const {
+    uint64_t total = 0;
+    for (uint64_t count : issueCounts) {
+        total += count;
+    }
+    return total;
+}
+
+void AuditReport::merge(const AuditReport& other, size_t limit) {
+    records += other.records;
+    players += other.players;
+    for (int i = 0; i < AUDIT_ISSUE_COUNT; i++) {
+        issueCounts[i] += other.issueCounts[i];
+    }
+    divergences.insert(divergences.end(), other.divergences.begin(), other.divergences.end());
+    std::stable_sort(divergences.begin(), divergences.end(), [](const AuditDivergence& a, const AuditDivergence& b) {
+        return a.record < b.record;
+    });
+    if (divergences.size() > limit) {
+        divergences.resize(limit);
+    }
+}
+
+PullLogVerifier::PullLogVerifier(size_t maxDivergenceValue) : maxDivergences(maxDivergenceValue) {}
+
+void PullLogVerifier::addCatalog(uint32_t bannerId, std::shared_ptr<const GachaCatalog> catalog, uint32_t pityTrack) {
+    if (bannerId >= PlayerColumns::MAX_COLUMNS) {
+        return;
+    }
+    if (catalog->needsCompile()) {
+        std::shared_ptr<GachaCatalog> copy = std::make_shared<GachaCatalog>(*catalog);
+        copy->compile();
+        catalog = copy;
+    }
+    if (banners.size() <= bannerId) {
+        banners.resize(bannerId + 1);
+    }
+    Banner& banner = banners[bannerId];
+    if (banner.versions.empty()) {
+        banner.pityTrack = pityTrack;
+    }
+    banner.versions.push_back(BannerVersion{ catalog->fingerprint(), std::move(catalog) });
+}
+
+void PullLogVerifier::addBanners(const BannerRegistry& registry) {
+    for (size_t i = 0; i < registry.size(); i++) {
+        const BannerEntry& entry = registry.getBanner(static_cast<uint32_t>(i));
+        addCatalog(static_cast<uint32_t>(i), entry.catalog, entry.pityTrack);
+    }
+}
+
+const GachaCatalog* PullLogVerifier::findCatalog(uint8_t bannerId, uint16_t version, uint32_t& pityTrack) const {
+    if (bannerId >= banners.size()) {
+        return nullptr;
+    }
+    const Banner& banner = banners[bannerId];
+    for (const BannerVersion& entry : banner.versions) {
+        if (entry.version == version) {
+            pityTrack = banner.pityTrack;
+            return entry.catalog.get();
+        }
+    }
+    return nullptr;
+}
+
+// Ujung rantai satu pemain di satu potongan: record pertamanya dan pullIndex berikutnya setelah record terakhir
+struct PlayerEdge {
+    const PullLogRecord* first;
+    uint64_t nextIndex;
+};
+
+// Ujung rantai satu jalur pity pemain: record pertama yang katalognya dikenal, hard pity katalog itu,
+// dan state jalur setelah record terakhir
+struct TrackEdge {
+    const PullLogRecord* first;
+    int hardPity;
+    TrackAudit last;
+};
+
+struct PullLogVerifier::RangeAudit {
+    AuditReport report;                             // players diisi saat disambung (pemain baru di catatan)
+    std::unordered_map<uint64_t, PlayerEdge> players;
+    std::unordered_map<uint64_t, TrackEdge> tracks; // Kunci = (playerId << 8) | jalur pity
+};
+
+void PullLogVerifier::verifyRange(const PullLogRecord* records, size_t count, uint64_t seed, uint64_t firstRecord,
+                                  RangeAudit& range) const {
+    AuditReport& report = range.report;
+    
+    // Record biasanya berkelompok per pemain, jadi entri terakhir disimpan agar lookup map hanya terjadi
+    // saat pemain berganti
+    PlayerEdge* player = nullptr;
+    uint64_t lastPlayer = 0;
+    TrackEdge* track = nullptr;
+    uint64_t lastTrackKey = 0;
+    
+    // Katalog record sebelumnya (biasanya sama untuk banyak record berurutan)
+    const GachaCatalog* catalog = nullptr;
+    uint32_t pityTrack = 0;
+    uint8_t lastBanner = 0;
+    uint16_t lastVersion = 0;
+    
+    Philox4x32Engine engine;
+    for (size_t i = 0; i < count; i++) {
+        const PullLogRecord& record = records[i];
+        uint64_t position = firstRecord + i;
+        report.records++;
+        
+        if (!player || record.playerId != lastPlayer) {
+            player = &range.players.try_emplace(record.playerId, PlayerEdge{ &record, record.pullIndex }).first->second;
+            lastPlayer = record.playerId;
+        }
+        if (record.pullIndex != player->nextIndex) {
+            addIssue(report, maxDivergences, position, record, AUDIT_SEQUENCE, nullptr);
+        }
+        player->nextIndex = record.pullIndex + 1;
+        
+        if (!catalog || record.bannerId != lastBanner || record.bannerVersion != lastVersion) {
+            catalog = findCatalog(record.bannerId, record.bannerVersion, pityTrack);
+            lastBanner = record.bannerId;
+            lastVersion = record.bannerVersion;
+        }
+        if (!catalog) {
+            addIssue(report, maxDivergences, position, record, AUDIT_UNKNOWN_BANNER, nullptr);
+            continue;
+        }
+        int hardPity = catalog->getHardPity();
+        if (record.pullNumber < 1 || record.pullNumber > hardPity) {
+            addIssue(report, maxDivergences, position, record, AUDIT_INVALID_STATE, nullptr);
+            continue;
+        }
+        
+        PityState state;
+        state.pullCount = record.pullNumber - 1;
+        state.selectedCharPity = record.selectedCharPity;
+        state.featuredState = record.featuredState;
+        
+        // Counter lama yang melewati hard pity katalog baru dipotong seperti saat katalog diganti.
+        // Jalur pity < 256, jadi muat di 8 bit bawah kunci
+        uint64_t trackKey = (record.playerId << 8) | pityTrack;
+        if (!track || trackKey != lastTrackKey) {
+            TrackEdge edge{ &record, hardPity, TrackAudit{ state.pullCount, state.featuredState } };
+            track = &range.tracks.try_emplace(trackKey, edge).first->second;
+            lastTrackKey = trackKey;
+        }
+        if (state.pullCount != std::min(track->last.pullCount, hardPity - 1) ||
+            state.featuredState != track->last.featuredState) {
+            addIssue(report, maxDivergences, position, record, AUDIT_PITY_CHAIN, nullptr);
+        }
+        
+        // Lompat langsung ke blok pullIndex di stream pemain (satu blok = satu pull)
+        uint64_t words[2];
+        engine.seed(seed, record.playerId);
+        engine.block(record.pullIndex, words);
+        GachaResult expected = catalog->resolvePull(state, toUnitDouble(words[0]), toUnitDouble(words[1]));
+        expected.bannerId = record.bannerId;
+        if (expected.characterId != record.characterId || packResultFlags(expected) != record.flags) {
+            addIssue(report, maxDivergences, position, record, AUDIT_RESULT, &expected);
+        }
+        
+        // Sambungan berikutnya memakai hasil yang tercatat, jadi satu record salah tidak merambat
+        bool ssr = (record.flags & ~PITY_FLAG) == RARITY_SSR;
+        track->last.pullCount = ssr ? 0 : record.pullNumber;
+        track->last.featuredState = ssr ?
+            catalog->nextFeaturedState(record.featuredState, record.characterId, record.selectedCharPity) :
+            record.featuredState;
+    }
+}
+
+AuditReport PullLogVerifier::verify(const PullLogRecord* records, size_t count, uint64_t seed, unsigned threads,
+                                    uint64_t firstRecord) const {
+    unsigned threadCount = threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+    size_t chunkCount = (count + CHUNK_RECORDS - 1) / CHUNK_RECORDS;
+    threadCount = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threadCount, chunkCount)));
+    
+    // Ujung rantai setiap pemain dan jalur pity setelah potongan yang sudah disambung
+    std::unordered_map<uint64_t, uint64_t> nextIndices;
+    std::unordered_map<uint64_t, TrackAudit> tracks;
+    AuditReport result;
+    
+    // Potongan diperiksa bergelombang (satu per thread) lalu disambung berurutan, sehingga memori ujung
+    // rantai tetap sebatas threadCount potongan berapa pun ukuran catatannya
+    std::vector<RangeAudit> ranges(threadCount);
+    for (size_t wave = 0; wave < chunkCount; wave += threadCount) {
+        size_t waveSize = std::min<size_t>(threadCount, chunkCount - wave);
+        auto work = [&](size_t index) {
+            size_t first = (wave + index) * CHUNK_RECORDS;
+            ranges[index] = RangeAudit();
+            verifyRange(records + first, std::min(CHUNK_RECORDS, count - first), seed, firstRecord + first,
+                        ranges[index]);
+        };
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < waveSize; i++) {
+            workers.emplace_back(work, i);
+        }
+        work(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        
+        // Record pertama pemain di potongan harus melanjutkan state terakhirnya di potongan sebelumnya.
+        // Urutan map tidak tentu, jadi masalah sambungan dikumpulkan tanpa batas lalu diurutkan oleh merge()
+        for (size_t i = 0; i < waveSize; i++) {
+            RangeAudit& range = ranges[i];
+            AuditReport joins;
+            for (const std::pair<const uint64_t, PlayerEdge>& entry : range.players) {
+                const PullLogRecord& first = *entry.second.first;
+                std::pair<std::unordered_map<uint64_t, uint64_t>::iterator, bool> inserted =
+                    nextIndices.try_emplace(entry.first, first.pullIndex);
+                joins.players += inserted.second ? 1 : 0;
+                if (first.pullIndex != inserted.first->second) {
+                    addIssue(joins, SIZE_MAX, firstRecord + static_cast<uint64_t>(&first - records), first, AUDIT_SEQUENCE, nullptr);
+                }
+                inserted.first->second = entry.second.nextIndex;
+            }
+            for (const std::pair<const uint64_t, TrackEdge>& entry : range.tracks) {
+                const TrackEdge& edge = entry.second;
+                const PullLogRecord& first = *edge.first;
+                int32_t pullCount = first.pullNumber - 1;
+                std::pair<std::unordered_map<uint64_t, TrackAudit>::iterator, bool> inserted =
+                    tracks.try_emplace(entry.first, TrackAudit{ pullCount, first.featuredState });
+                const TrackAudit& previous = inserted.first->second;
+                if (pullCount != std::min(previous.pullCount, edge.hardPity - 1) ||
+                    first.featuredState != previous.featuredState) {
+                    addIssue(joins, SIZE_MAX, firstRecord + static_cast<uint64_t>(&first - records), first, AUDIT_PITY_CHAIN, nullptr);
+                }
+                inserted.first->second = edge.last;
+            }
+            result.merge(joins, maxDivergences);
+            result.merge(range.report, maxDivergences);
+        }
+    }
+    return result;
+}
+
+bool PullLogVerifier::verifyFile(const std::string& path, AuditReport& report, unsigned threads, uint64_t firstRecord,
+                                 uint64_t count) const {
+    MappedFile mapped;
+    uint64_t seed = 0;
+    RngKind kind = RNG_PHILOX4X32;
+    if (!mapped.open(path) || !PullLog::readHeader(mapped.bytes(), mapped.length(), seed, kind) ||
+        kind != RNG_PHILOX4X32) {
+        return false;
+    }
+    const PullLogRecord* records = nullptr;
+    size_t total = 0;
+    std::vector<PullLogRecord> converted;
+    PullLog::records(mapped, records, total, converted);
+    uint64_t first = std::min<uint64_t>(firstRecord, total);
+    size_t selected = static_cast<size_t>(std::min<uint64_t>(count, total - first));
+    report = verify(records + first, selected, seed, threads, first);
+    return true;
+}
@@ -0,0 +1,115 @@
+#ifndef GACHA_PULL_AUDIT_H
+#define GACHA_PULL_AUDIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "banner_registry.h"
+#include "gacha_catalog.h"
+#include "gacha_types.h"
+#include "pull_log.h"
+
+// Jenis ketidakcocokan yang ditemukan verifier catatan pull
+enum AuditIssue : uint8_t {
+    AUDIT_RESULT = 0,           // Hasil tercatat berbeda dengan pull yang diulang dari seed, stream dan pullIndex
+    AUDIT_UNKNOWN_BANNER = 1,   // Banner atau versi katalognya tidak terdaftar di verifier
+    AUDIT_INVALID_STATE = 2,    // Nomor pull di luar 1..hard pity katalognya
+    AUDIT_SEQUENCE = 3,         // pullIndex tidak melanjutkan record sebelumnya milik pemain yang sama
+    AUDIT_PITY_CHAIN = 4,       // Counter atau state rate-up tidak menyambung dari pull sebelumnya di jalur pity yang sama
+    AUDIT_ISSUE_COUNT = 5
+};
+
+// Nama jenis ketidakcocokan untuk keluaran ("result", "sequence", ...)
+const char* auditIssueName(AuditIssue issue);
+
+// Satu ketidakcocokan di satu record
+struct AuditDivergence {
+    uint64_t record;        // Posisi record di catatan (mulai 0, dihitung dari awal file)
+    uint64_t playerId;
+    uint64_t pullIndex;
+    AuditIssue issue;
+    GachaResult expected;   // Hasil pull yang diulang (hanya diisi untuk AUDIT_RESULT)
+};
+
+// Hasil verifikasi: jumlah per jenis masalah dan daftar ketidakcocokan pertama
+struct AuditReport {
+    uint64_t records;                           // Record yang diperiksa
+    uint64_t players;                           // Stream pemain berbeda
+    uint64_t issueCounts[AUDIT_ISSUE_COUNT];
+    std::vector<AuditDivergence> divergences;   // Paling banyak maxDivergences, urut posisi record
+    
+    AuditReport();
+    
+    // Total ketidakcocokan (satu record bisa punya lebih dari satu)
+    uint64_t divergenceCount() const;
+    
+    bool clean() const {
+        return divergenceCount() == 0;
+    }
+    
+    // Menggabungkan laporan bagian lain, daftar diurutkan per posisi record lalu dipotong ke limit pertama
+    void merge(const AuditReport& other, size_t limit);
+};
+
+// Verifier catatan pull: setiap record diulang dari seed catatan, stream pemain (ID pemain), pullIndex
+// dan katalog versi banner-nya, lalu hasilnya dibandingkan dengan yang tercatat. Philox bisa langsung
+// melompat ke blok mana pun dan state pity sebelum pull ada di record, jadi verifikasi bisa dimulai dari
+// record mana saja tanpa mengulang stream dari awal. Record disambungkan dengan record sebelumnya milik
+// pemain yang sama di potongan yang diperiksa (urutan pullIndex, counter dan state rate-up per jalur).
+// Catatan dibagi menjadi potongan record berurutan yang diperiksa thread berbeda (setiap record dibaca
+// sekali); rantai pemain disambung di batas potongan dari record pertama dan state terakhir pemain di
+// setiap potongan. Ukuran potongan tetap, jadi hasilnya tidak bergantung pada jumlah thread
+class PullLogVerifier {
+private:
+    // Jumlah record per potongan yang diperiksa satu thread
+    static constexpr size_t CHUNK_RECORDS = 1 << 16;
+    
+    // Hasil satu potongan beserta ujung rantai pemainnya (didefinisikan di pull_audit.cpp)
+    struct RangeAudit;
+    
+    struct BannerVersion {
+        uint16_t version;
+        std::shared_ptr<const GachaCatalog> catalog;
+    };
+    
+    struct Banner {
+        uint32_t pityTrack;
+        std::vector<BannerVersion> versions;
+    };
+    
+    std::vector<Banner> banners;    // Indeks = ID banner
+    size_t maxDivergences;
+    
+    const GachaCatalog* findCatalog(uint8_t bannerId, uint16_t version, uint32_t& pityTrack) const;
+    
+    // Memeriksa count record berurutan; rantai pemain dari potongan sebelumnya disambung di verify()
+    void verifyRange(const PullLogRecord* records, size_t count, uint64_t seed, uint64_t firstRecord,
+                     RangeAudit& range) const;
+
+public:
+    // maxDivergences = jumlah ketidakcocokan yang disimpan di laporan (semuanya tetap dihitung)
+    explicit PullLogVerifier(size_t maxDivergenceValue = 1000);
+    
+    // Mendaftarkan katalog satu versi banner (mis. katalog lama sebelum banner diganti). Jalur pity banner
+    // mengikuti pendaftaran pertamanya; katalog yang belum dikompilasi disalin lalu dikompilasi
+    void addCatalog(uint32_t bannerId, std::shared_ptr<const GachaCatalog> catalog, uint32_t pityTrack = 0);
+    
+    // Mendaftarkan katalog semua banner registry beserta jalur pity-nya
+    void addBanners(const BannerRegistry& registry);
+    
+    // Memeriksa count record yang ditulis dengan seed Philox tertentu. firstRecord = posisi records[0]
+    // di catatan (untuk nomor record di laporan). threads 0 = semua core
+    AuditReport verify(const PullLogRecord* records, size_t count, uint64_t seed, unsigned threads = 0,
+                       uint64_t firstRecord = 0) const;
+    
+    // Memetakan file catatan pull lalu memeriksa count record mulai record ke-firstRecord.
+    // False jika file tidak bisa dibaca, catatan versi 1 (tanpa seed) atau engine random-nya bukan philox4x32
+    // (tidak bisa melompat)
+    bool verifyFile(const std::string& path, AuditReport& report, unsigned threads = 0, uint64_t firstRecord = 0,
+                    uint64_t count = UINT64_MAX) const;
+};
+
+#endif // GACHA_PULL_AUDIT_H
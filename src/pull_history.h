@@ -0,0 +1,327 @@
+#ifndef GACHA_PULL_HISTORY_H
+#define GACHA_PULL_HISTORY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "gacha_types.h"
+#include "pull_log.h"
+#include "snapshot.h"
+
+// Riwayat pull berbentuk kolom (ID karakter, nomor pull, flag) dengan batas opsional.
+// Kolom disimpan per chunk berukuran tetap yang tidak pernah dipindah: riwayat yang tumbuh hanya
+// menambah chunk baru (tanpa menyalin isi lama), dan setelah reserve() atau saat ring buffer
+// sudah penuh, mencatat pull sama sekali tidak mengalokasi memori
+class PullHistory {
+public:
+    // Jumlah entri per chunk (pangkat dua agar posisi dipecah dengan shift dan mask)
+    static constexpr size_t CHUNK_SHIFT = 12;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_SHIFT;
+
+private:
+    struct Chunk {
+        uint32_t characterIds[CHUNK_SIZE];
+        uint16_t pullNumbers[CHUNK_SIZE];
+        uint8_t flags[CHUNK_SIZE];    // Bit 0-6: rarity, bit 7: pity
+    };
+    
+    std::deque<Chunk> chunks;     // Bisa berisi chunk cadangan dari reserve() di luar entryCount
+    size_t entryCount;            // Jumlah entri yang disimpan
+    size_t capacity;              // 0 = tanpa batas, selain itu ring buffer
+    size_t head;                  // Posisi entri tertua saat ring buffer penuh
+    uint64_t totalRecorded;       // Total pull yang pernah dicatat
+    
+    // Counter agregat seumur hidup, diperbarui setiap pull
+    std::vector<uint64_t> characterCounts;
+    uint64_t rarityCounts[RARITY_COUNT];
+    uint64_t noCharacterCounts[RARITY_COUNT];
+    uint64_t pityCount;
+    
+    // Memperbarui counter agregat untuk satu hasil pull
+    void countResult(const GachaResult& result) {
+        totalRecorded++;
+        if (result.characterId == NO_CHARACTER) {
+            noCharacterCounts[result.rarity]++;
+        } else {
+            if (result.characterId >= characterCounts.size()) {
+                characterCounts.resize(result.characterId + 1, 0);
+            }
+            characterCounts[result.characterId]++;
+        }
+        rarityCounts[result.rarity]++;
+        if (result.isPity) {
+            pityCount++;
+        }
+    }
+    
+    // Mengubah indeks urutan (0 = tertua) menjadi posisi di dalam kolom
+    size_t slot(size_t index) const {
+        size_t position = head + index;
+        return position < entryCount ? position : position - entryCount;
+    }
+    
+    Chunk& chunkAt(size_t position) {
+        return chunks[position >> CHUNK_SHIFT];
+    }
+    
+    const Chunk& chunkAt(size_t position) const {
+        return chunks[position >> CHUNK_SHIFT];
+    }
+    
+    // Menulis satu hasil ke posisi kolom tertentu (chunk-nya harus sudah ada)
+    void store(size_t position, const GachaResult& result) {
+        Chunk& chunk = chunkAt(position);
+        size_t offset = position & (CHUNK_SIZE - 1);
+        chunk.characterIds[offset] = result.characterId;
+        chunk.pullNumbers[offset] = static_cast<uint16_t>(result.pullNumber);
+        chunk.flags[offset] = packResultFlags(result);
+    }
+    
+    // Memastikan chunk untuk posisi kolom 0..count-1 sudah ada
+    void ensureChunks(size_t count) {
+        while (chunks.size() << CHUNK_SHIFT < count) {
+            chunks.emplace_back();
+        }
+    }
+    
+    // Menulis posisi kolom [from, to) dari satu kolom chunk sebagai byte berurutan
+    template <typename T>
+    void putColumn(SnapshotWriter& writer, T (Chunk::*column)[CHUNK_SIZE], size_t from, size_t to) const {
+        while (from < to) {
+            size_t offset = from & (CHUNK_SIZE - 1);
+            size_t count = std::min(CHUNK_SIZE - offset, to - from);
+            writer.putBytes((chunkAt(from).*column) + offset, count * sizeof(T));
+            from += count;
+        }
+    }
+
+public:
+    explicit PullHistory(size_t capacityValue = 0) :
+        entryCount(0),
+        capacity(capacityValue),
+        head(0),
+        totalRecorded(0),
+        pityCount(0) {
+        std::fill(rarityCounts, rarityCounts + RARITY_COUNT, 0);
+        std::fill(noCharacterCounts, noCharacterCounts + RARITY_COUNT, 0);
+    }
+    
+    // Menyiapkan tempat untuk entries entri dan counter untuk characterCount karakter,
+    // agar pull berikutnya sampai batas itu tidak mengalokasi memori sama sekali
+    void reserve(size_t entries, size_t characterCount = 0) {
+        if (capacity != 0) {
+            entries = std::min(entries, capacity);
+        }
+        ensureChunks(entries);
+        if (characterCount > characterCounts.size()) {
+            characterCounts.resize(characterCount, 0);
+        }
+    }
+    
+    // Mencatat satu hasil pull
+    void record(const GachaResult& result) {
+        if (capacity == 0 || entryCount < capacity) {
+            ensureChunks(entryCount + 1);
+            store(entryCount, result);
+            entryCount++;
+        } else {
+            // Ring buffer penuh: timpa entri tertua
+            store(head, result);
+            head = (head + 1 == capacity) ? 0 : head + 1;
+        }
+        countResult(result);
+    }
+    
+    // Mencatat banyak hasil pull sekaligus
+    void append(const GachaResult* results, size_t count) {
+        // Bagian yang masih muat ditulis langsung ke kolom, per potongan chunk
+        size_t direct = capacity == 0 ? count : std::min(count, capacity - std::min(capacity, entryCount));
+        ensureChunks(entryCount + direct);
+        size_t done = 0;
+        while (done < direct) {
+            Chunk& chunk = chunkAt(entryCount);
+            size_t offset = entryCount & (CHUNK_SIZE - 1);
+            size_t part = std::min(CHUNK_SIZE - offset, direct - done);
+            uint32_t* idColumn = chunk.characterIds + offset;
+            uint16_t* pullNumberColumn = chunk.pullNumbers + offset;
+            uint8_t* flagColumn = chunk.flags + offset;
+            for (size_t i = 0; i < part; i++) {
+                const GachaResult& result = results[done + i];
+                idColumn[i] = result.characterId;
+                pullNumberColumn[i] = static_cast<uint16_t>(result.pullNumber);
+                flagColumn[i] = packResultFlags(result);
+                countResult(result);
+            }
+            entryCount += part;
+            done += part;
+        }
+        
+        // Sisanya masuk lewat jalur ring buffer
+        for (size_t i = direct; i < count; i++) {
+            record(results[i]);
+        }
+    }
+    
+    // Mengatur batas jumlah entri (0 = tanpa batas), entri tertua dibuang jika perlu
+    void setCapacity(size_t capacityValue) {
+        size_t keep = size();
+        if (capacityValue != 0 && keep > capacityValue) {
+            keep = capacityValue;
+        }
+        
+        // Susun ulang kolom agar entri tertua kembali di posisi 0
+        std::deque<Chunk> newChunks((keep + CHUNK_SIZE - 1) >> CHUNK_SHIFT);
+        size_t skip = size() - keep;
+        for (size_t i = 0; i < keep; i++) {
+            size_t position = slot(skip + i);
+            const Chunk& from = chunkAt(position);
+            Chunk& to = newChunks[i >> CHUNK_SHIFT];
+            size_t fromOffset = position & (CHUNK_SIZE - 1);
+            size_t toOffset = i & (CHUNK_SIZE - 1);
+            to.characterIds[toOffset] = from.characterIds[fromOffset];
+            to.pullNumbers[toOffset] = from.pullNumbers[fromOffset];
+            to.flags[toOffset] = from.flags[fromOffset];
+        }
+        
+        chunks.swap(newChunks);
+        entryCount = keep;
+        capacity = capacityValue;
+        head = 0;
+    }
+    
+    // Jumlah entri yang masih disimpan
+    size_t size() const {
+        return entryCount;
+    }
+    
+    bool empty() const {
+        return entryCount == 0;
+    }
+    
+    // Mendapatkan entri ke-index (0 = tertua yang masih disimpan)
+    GachaResult operator[](size_t index) const {
+        size_t position = slot(index);
+        const Chunk& chunk = chunkAt(position);
+        size_t offset = position & (CHUNK_SIZE - 1);
+        GachaResult result;
+        result.characterId = chunk.characterIds[offset];
+        result.rarity = static_cast<Rarity>(chunk.flags[offset] & ~PITY_FLAG);
+        result.isPity = (chunk.flags[offset] & PITY_FLAG) != 0;
+        result.bannerId = 0;
+        result.pullNumber = chunk.pullNumbers[offset];
+        return result;
+    }
+    
+    // Menyalin count entri mulai index (0 = tertua) sebagai record catatan pull milik playerId.
+    // Riwayat tidak menyimpan kolom audit, jadi record ini untuk analisis, bukan untuk diverifikasi ulang
+    void exportRecords(size_t index, size_t count, uint64_t playerId, PullLogRecord* out) const {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = makePullLogRecord(playerId, firstPullIndex() + index + i, (*this)[index + i]);
+        }
+    }
+    
+    // Total pull yang pernah dicatat (termasuk yang sudah dibuang ring buffer)
+    uint64_t totalPulls() const {
+        return totalRecorded;
+    }
+    
+    // Nomor urut global (mulai 0) dari entri tertua yang masih disimpan
+    uint64_t firstPullIndex() const {
+        return totalRecorded - entryCount;
+    }
+    
+    uint64_t getCharacterCount(uint32_t characterId) const {
+        return characterId < characterCounts.size() ? characterCounts[characterId] : 0;
+    }
+    
+    uint64_t getRarityCount(Rarity rarity) const {
+        return rarityCounts[rarity];
+    }
+    
+    // Jumlah pull tanpa karakter (contoh: "Common Item") untuk rarity tertentu
+    uint64_t getNoCharacterCount(Rarity rarity) const {
+        return noCharacterCounts[rarity];
+    }
+    
+    uint64_t getPityCount() const {
+        return pityCount;
+    }
+    
+    // Perkiraan memori yang dipakai kolom riwayat (byte, termasuk chunk cadangan)
+    size_t memoryUsage() const {
+        return chunks.size() * sizeof(Chunk);
+    }
+    
+    // Menulis riwayat dan counter agregat sebagai satu section snapshot (kolom urut kronologis)
+    void writeTo(SnapshotWriter& writer) const {
+        writer.beginSection(SECTION_HISTORY);
+        writer.put<uint64_t>(totalRecorded);
+        writer.put<uint64_t>(capacity);
+        writer.put<uint64_t>(pityCount);
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            writer.put<uint64_t>(rarityCounts[i]);
+            writer.put<uint64_t>(noCharacterCounts[i]);
+        }
+        writer.put<uint64_t>(characterCounts.size());
+        writer.put<uint64_t>(entryCount);
+        writer.putArray(characterCounts.data(), characterCounts.size());
+        
+        // Ring buffer ditulis dua potong agar entri tertua berada di depan
+        writer.align();
+        putColumn(writer, &Chunk::characterIds, head, entryCount);
+        putColumn(writer, &Chunk::characterIds, 0, head);
+        writer.align();
+        putColumn(writer, &Chunk::pullNumbers, head, entryCount);
+        putColumn(writer, &Chunk::pullNumbers, 0, head);
+        writer.align();
+        putColumn(writer, &Chunk::flags, head, entryCount);
+        putColumn(writer, &Chunk::flags, 0, head);
+        writer.endSection();
+    }
+    
+    // Memuat riwayat dari section snapshot, false (tanpa perubahan) jika isinya tidak valid
+    bool readFrom(SnapshotReader& reader) {
+        uint64_t total = reader.get<uint64_t>();
+        uint64_t capacityValue = reader.get<uint64_t>();
+        uint64_t pity = reader.get<uint64_t>();
+        uint64_t rarities[RARITY_COUNT];
+        uint64_t noCharacters[RARITY_COUNT];
+        for (int i = 0; i < RARITY_COUNT; i++) {
+            rarities[i] = reader.get<uint64_t>();
+            noCharacters[i] = reader.get<uint64_t>();
+        }
+        uint64_t countSize = reader.get<uint64_t>();
+        uint64_t entries = reader.get<uint64_t>();
+        const uint64_t* counts = reader.getArray<uint64_t>(countSize);
+        const uint32_t* ids = reader.getArray<uint32_t>(entries);
+        const uint16_t* numbers = reader.getArray<uint16_t>(entries);
+        const uint8_t* flagColumn = reader.getArray<uint8_t>(entries);
+        if (!reader.ok() || entries > total || (capacityValue != 0 && entries > capacityValue)) {
+            return false;
+        }
+        
+        std::deque<Chunk> newChunks((entries + CHUNK_SIZE - 1) >> CHUNK_SHIFT);
+        for (size_t first = 0; first < entries; first += CHUNK_SIZE) {
+            Chunk& chunk = newChunks[first >> CHUNK_SHIFT];
+            size_t count = std::min<size_t>(CHUNK_SIZE, entries - first);
+            std::copy(ids + first, ids + first + count, chunk.characterIds);
+            std::copy(numbers + first, numbers + first + count, chunk.pullNumbers);
+            std::copy(flagColumn + first, flagColumn + first + count, chunk.flags);
+        }
+        chunks.swap(newChunks);
+        entryCount = static_cast<size_t>(entries);
+        characterCounts.assign(counts, counts + countSize);
+        capacity = static_cast<size_t>(capacityValue);
+        head = 0;
+        totalRecorded = total;
+        pityCount = pity;
+        std::copy(rarities, rarities + RARITY_COUNT, rarityCounts);
+        std::copy(noCharacters, noCharacters + RARITY_COUNT, noCharacterCounts);
+        return true;
+    }
+};
+
+#endif // GACHA_PULL_HISTORY_H
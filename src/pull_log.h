@@ -0,0 +1,297 @@
+#ifndef GACHA_PULL_LOG_H
+#define GACHA_PULL_LOG_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gacha_rng.h"
+#include "gacha_types.h"
+#include "snapshot.h"
+
+// Satu record catatan pull append-only (32 byte, urutan per pemain sesuai pullIndex).
+// Bersama seed di header, record cukup untuk mengulang pull-nya: stream Philox (seed, playerId)
+// di blok pullIndex, katalog versi bannerVersion, dan state pity sebelum pull
+// (counter = pullNumber - 1, karakter pilihan, state rate-up)
+struct PullLogRecord {
+    uint64_t playerId;          // Juga ID stream random pemain
+    uint64_t pullIndex;         // Pull ke-berapa milik pemain ini (mulai 0) = posisi di stream random
+    uint32_t characterId;
+    uint32_t selectedCharPity;  // Karakter pity/pilihan saat pull
+    uint16_t pullNumber;
+    uint16_t bannerVersion;     // GachaCatalog::fingerprint() katalog yang dipakai
+    uint8_t flags;              // packResultFlags()
+    uint8_t bannerId;           // Banner tempat pull dilakukan (0 pada catatan dari server satu banner)
+    uint8_t featuredState;      // State rate-up sebelum pull
+    uint8_t reserved;
+};
+
+static_assert(sizeof(PullLogRecord) == 32, "PullLogRecord harus 32 byte");
+
+// Record untuk satu hasil pull; kolom audit (karakter pilihan, versi banner, state rate-up) diisi 0
+inline PullLogRecord makePullLogRecord(uint64_t playerId, uint64_t pullIndex, const GachaResult& result) {
+    PullLogRecord record;
+    record.playerId = playerId;
+    record.pullIndex = pullIndex;
+    record.characterId = result.characterId;
+    record.selectedCharPity = 0;
+    record.pullNumber = static_cast<uint16_t>(result.pullNumber);
+    record.bannerVersion = 0;
+    record.flags = packResultFlags(result);
+    record.bannerId = result.bannerId;
+    record.featuredState = 0;
+    record.reserved = 0;
+    return record;
+}
+
+// Catatan pull append-only: setiap pull hanya menambah satu record di akhir file.
+// Snapshot + catatan sesudahnya cukup untuk memulihkan state pity semua pemain.
+// Header menyimpan seed dan engine random semua stream di file (versi 2). Versi 1 (header 16 byte tanpa seed,
+// record 24 byte tanpa kolom audit) tetap dibaca dan dilanjutkan: bisa diputar ulang, tidak bisa diverifikasi
+class PullLog {
+private:
+    FILE* file;
+    uint64_t seedValue;
+    RngKind rngKind;
+    uint32_t version;   // Versi format file yang dibuka
+    std::mutex mutex;
+    
+    PullLog(const PullLog&) = delete;
+    PullLog& operator=(const PullLog&) = delete;
+
+public:
+    static constexpr size_t HEADER_SIZE = 32;
+    static constexpr char MAGIC[8] = { 'G', 'A', 'C', 'H', 'A', 'L', 'O', 'G' };
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t V1_HEADER_SIZE = 16;
+    static constexpr size_t V1_RECORD_SIZE = 24;
+    
+    PullLog() : file(nullptr), seedValue(0), rngKind(RNG_PHILOX4X32), version(VERSION) {}
+    
+    ~PullLog() {
+        close();
+    }
+    
+    // Membuka (atau membuat) file catatan untuk ditambah oleh stream dengan seed dan engine tertentu.
+    // File versi 1 dilanjutkan dalam formatnya sendiri (seed diabaikan). Sisa tulisan yang terpotong
+    // (crash saat append) dibuang dulu agar record baru mulai di batas record; file yang baru berisi
+    // sebagian header dibuat ulang. False jika file lama punya header lain (format tidak dikenal, atau
+    // seed/engine versi 2 berbeda) atau tidak bisa dipotong
+    bool open(const std::string& path, uint64_t seed, RngKind kind = RNG_PHILOX4X32) {
+        close();
+        uint32_t fileVersion = VERSION;
+        FILE* existing = std::fopen(path.c_str(), "rb");
+        if (existing) {
+            char header[HEADER_SIZE];
+            size_t read = std::fread(header, 1, HEADER_SIZE, existing);
+            std::fclose(existing);
+            std::error_code error;
+            uint64_t size = std::filesystem::file_size(path, error);
+            if (error) {
+                return false;
+            }
+            
+            uint64_t whole = 0;
+            if (read > 0 && !isTornHeader(header, read)) {
+                uint64_t fileSeed = 0;
+                RngKind fileKind = RNG_PHILOX4X32;
+                fileVersion = versionOf(header, read);
+                if (fileVersion == 0 || (fileVersion == VERSION && (!readHeader(header, read, fileSeed, fileKind) ||
+                                                                    fileSeed != seed || fileKind != kind))) {
+                    return false;
+                }
+                size_t recordBytes = recordSize(fileVersion);
+                whole = headerSize(fileVersion) + (size - headerSize(fileVersion)) / recordBytes * recordBytes;
+            } else {
+                fileVersion = VERSION;
+            }
+            if (whole != size) {
+                std::filesystem::resize_file(path, whole, error);
+                if (error) {
+                    return false;
+                }
+            }
+        }
+        
+        file = std::fopen(path.c_str(), "ab");
+        if (!file) {
+            return false;
+        }
+        std::fseek(file, 0, SEEK_END);
+        if (std::ftell(file) == 0) {
+            char header[HEADER_SIZE];
+            writeHeader(header, seed, kind);
+            std::fwrite(header, 1, HEADER_SIZE, file);
+        }
+        version = fileVersion;
+        seedValue = fileVersion == VERSION ? seed : 0;
+        rngKind = kind;
+        return true;
+    }
+    
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+    
+    bool isOpen() const {
+        return file != nullptr;
+    }
+    
+    // Seed dan engine random yang tercatat di header
+    uint64_t getSeed() const {
+        return seedValue;
+    }
+    
+    RngKind getRngKind() const {
+        return rngKind;
+    }
+    
+    // False untuk catatan versi 1: seed tidak tercatat, jadi pull-nya tidak bisa diulang untuk verifikasi
+    bool hasSeed() const {
+        return version >= 2;
+    }
+    
+    // Menambah record secara berurutan (aman dari banyak thread); di file versi 1 kolom audit dibuang
+    bool append(const PullLogRecord* records, size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file) {
+            return false;
+        }
+        if (version == VERSION) {
+            return std::fwrite(records, sizeof(PullLogRecord), count, file) == count;
+        }
+        char chunk[256 * V1_RECORD_SIZE];
+        for (size_t done = 0; done < count; done += 256) {
+            size_t chunkSize = std::min<size_t>(256, count - done);
+            for (size_t i = 0; i < chunkSize; i++) {
+                toV1(records[done + i], chunk + i * V1_RECORD_SIZE);
+            }
+            if (std::fwrite(chunk, V1_RECORD_SIZE, chunkSize, file) != chunkSize) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    bool flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return file && std::fflush(file) == 0;
+    }
+    
+    // Header: magic, versi u32, ukuran record u32, seed u64, engine random u8, sisanya 0
+    static void writeHeader(char header[HEADER_SIZE], uint64_t seed, RngKind kind) {
+        std::memset(header, 0, HEADER_SIZE);
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        uint32_t fileRecordSize = sizeof(PullLogRecord);
+        std::memcpy(header + 8, &VERSION, sizeof(VERSION));
+        std::memcpy(header + 12, &fileRecordSize, sizeof(fileRecordSize));
+        std::memcpy(header + 16, &seed, sizeof(seed));
+        header[24] = static_cast<char>(kind);
+    }
+    
+    // Versi format header (1 atau 2), 0 jika bukan catatan pull yang didukung atau header-nya terpotong
+    static uint32_t versionOf(const char* header, size_t size) {
+        uint32_t fileVersion = 0;
+        uint32_t fileRecordSize = 0;
+        if (size < V1_HEADER_SIZE || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+            return 0;
+        }
+        std::memcpy(&fileVersion, header + 8, sizeof(fileVersion));
+        std::memcpy(&fileRecordSize, header + 12, sizeof(fileRecordSize));
+        if (fileVersion == 1 && fileRecordSize == V1_RECORD_SIZE) {
+            return 1;
+        }
+        if (fileVersion == VERSION && fileRecordSize == sizeof(PullLogRecord) && size >= HEADER_SIZE) {
+            return VERSION;
+        }
+        return 0;
+    }
+    
+    // True jika size byte ini awal header catatan pull yang terpotong sebelum selesai ditulis
+    static bool isTornHeader(const char* header, size_t size) {
+        if (size >= HEADER_SIZE || std::memcmp(header, MAGIC, std::min(size, sizeof(MAGIC))) != 0) {
+            return false;
+        }
+        if (size < 12) {
+            return true;
+        }
+        uint32_t fileVersion = 0;
+        std::memcpy(&fileVersion, header + 8, sizeof(fileVersion));
+        return fileVersion == VERSION || (fileVersion == 1 && size < V1_HEADER_SIZE);
+    }
+    
+    // Ukuran header dan record versi tertentu
+    static size_t headerSize(uint32_t fileVersion) {
+        return fileVersion == 1 ? V1_HEADER_SIZE : HEADER_SIZE;
+    }
+    
+    static size_t recordSize(uint32_t fileVersion) {
+        return fileVersion == 1 ? V1_RECORD_SIZE : sizeof(PullLogRecord);
+    }
+    
+    // Membaca seed dan engine random dari header, false jika formatnya tidak cocok atau versi 1 (tanpa seed)
+    static bool readHeader(const char* header, size_t size, uint64_t& seed, RngKind& kind) {
+        if (versionOf(header, size) != VERSION) {
+            return false;
+        }
+        std::memcpy(&seed, header + 16, sizeof(seed));
+        kind = static_cast<RngKind>(header[24]);
+        return true;
+    }
+    
+    // Record versi 1 (24 byte) dari/ke record saat ini; kolom audit record versi 1 bernilai 0
+    static void toV1(const PullLogRecord& record, char* out) {
+        std::memcpy(out, &record.playerId, sizeof(record.playerId));
+        std::memcpy(out + 8, &record.pullIndex, sizeof(record.pullIndex));
+        std::memcpy(out + 16, &record.characterId, sizeof(record.characterId));
+        std::memcpy(out + 20, &record.pullNumber, sizeof(record.pullNumber));
+        out[22] = static_cast<char>(record.flags);
+        out[23] = static_cast<char>(record.bannerId);
+    }
+    
+    static PullLogRecord fromV1(const char* in) {
+        PullLogRecord record = PullLogRecord();
+        std::memcpy(&record.playerId, in, sizeof(record.playerId));
+        std::memcpy(&record.pullIndex, in + 8, sizeof(record.pullIndex));
+        std::memcpy(&record.characterId, in + 16, sizeof(record.characterId));
+        std::memcpy(&record.pullNumber, in + 20, sizeof(record.pullNumber));
+        record.flags = static_cast<uint8_t>(in[22]);
+        record.bannerId = static_cast<uint8_t>(in[23]);
+        return record;
+    }
+    
+    // Record di file yang sudah dipetakan; record terakhir yang terpotong (crash saat menulis) diabaikan.
+    // Record versi 2 dibaca langsung dari memori, record versi 1 dikonversi ke converted.
+    // False jika header-nya bukan catatan pull yang didukung
+    static bool records(const MappedFile& mapped, const PullLogRecord*& out, size_t& count,
+                        std::vector<PullLogRecord>& converted) {
+        out = nullptr;
+        count = 0;
+        uint32_t fileVersion = versionOf(mapped.bytes(), mapped.length());
+        if (fileVersion == VERSION) {
+            count = (mapped.length() - HEADER_SIZE) / sizeof(PullLogRecord);
+            out = reinterpret_cast<const PullLogRecord*>(mapped.bytes() + HEADER_SIZE);
+        } else if (fileVersion == 1) {
+            count = (mapped.length() - V1_HEADER_SIZE) / V1_RECORD_SIZE;
+            converted.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                converted[i] = fromV1(mapped.bytes() + V1_HEADER_SIZE + i * V1_RECORD_SIZE);
+            }
+            out = converted.data();
+        }
+        return fileVersion != 0;
+    }
+};
+
+#endif // GACHA_PULL_LOG_H
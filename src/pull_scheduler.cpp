@@ -0,0 +1,140 @@
+#include "pull_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+PullScheduler::PullScheduler(GachaServer& gachaServer, GachaExecutor& executorValue, size_t maxBatchValue,
+                             std::chrono::microseconds maxWaitValue) :
+    server(gachaServer),
+    executor(executorValue),
+    queuedPulls(0),
+    maxBatch(std::max<size_t>(1, maxBatchValue)),
+    maxWait(maxWaitValue),
+    batchCount(0),
+    stopping(false),
+    okCapacity(0) {
+    dispatcher = std::thread([this] { run(); });
+}
+
+PullScheduler::~PullScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    dispatcher.join();
+}
+
+void PullScheduler::setMaxBatch(size_t value) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        maxBatch = std::max<size_t>(1, value);
+    }
+    ready.notify_one();
+}
+
+void PullScheduler::setMaxWait(std::chrono::microseconds value) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        maxWait = value;
+    }
+    ready.notify_one();
+}
+
+uint64_t PullScheduler::batchesRun() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return batchCount;
+}
+
+void PullScheduler::enqueue(const PullRequest& request, std::vector<GachaResult>* output, bool* ok,
+                            std::coroutine_handle<> handle) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        
+        // Dispatcher hanya dibangunkan saat antrean mulai terisi (timer maxWait mulai) atau batch penuh
+        wake = queue.empty() || (queuedPulls < maxBatch && queuedPulls + request.count >= maxBatch);
+        queue.push_back(Pending{ request, output, ok, handle, std::chrono::steady_clock::now() });
+        queuedPulls += request.count;
+    }
+    if (wake) {
+        ready.notify_one();
+    }
+}
+
+void PullScheduler::runBatch() {
+    size_t total = 0;
+    requests.clear();
+    for (const Pending& pending : batch) {
+        requests.push_back(pending.request);
+        total += pending.request.count;
+    }
+    results.resize(total);
+    if (okCapacity < batch.size()) {
+        okCapacity = std::max(batch.size(), okCapacity * 2);
+        okFlags.reset(new bool[okCapacity]);
+    }
+    
+    server.pullBatch(requests.data(), requests.size(), results.data(), okFlags.get());
+    
+    size_t offset = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+        const Pending& pending = batch[i];
+        *pending.ok = okFlags[i];
+        if (okFlags[i]) {
+            pending.results->assign(results.begin() + offset, results.begin() + offset + pending.request.count);
+        }
+        offset += pending.request.count;
+        executor.post(pending.handle);
+    }
+}
+
+// Menunggu batch penuh atau maxWait habis, mengambil permintaan terdepan sebanyak maxBatch pull lalu menjalankannya
+void PullScheduler::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        ready.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        // Batas waktu dihitung ulang setiap bangun agar setMaxWait() langsung berlaku
+        while (!stopping && queuedPulls < maxBatch &&
+               std::chrono::steady_clock::now() < queue.front().queuedAt + maxWait) {
+            ready.wait_until(lock, queue.front().queuedAt + maxWait);
+        }
+        
+        size_t taken = 0;
+        size_t pulls = 0;
+        while (taken < queue.size() && (taken == 0 || pulls + queue[taken].request.count <= maxBatch)) {
+            pulls += queue[taken].request.count;
+            taken++;
+        }
+        batch.assign(queue.begin(), queue.begin() + taken);
+        queue.erase(queue.begin(), queue.begin() + taken);
+        queuedPulls -= pulls;
+        batchCount++;
+        lock.unlock();
+        
+        runBatch();
+        
+        lock.lock();
+    }
+}
+
+Task<std::vector<GachaResult>> PullScheduler::multiPull(uint64_t playerId, uint32_t bannerId, int count) {
+    if (count <= 0) {
+        co_return std::vector<GachaResult>();
+    }
+    PullAwaiter awaiter{ *this, PullRequest{ playerId, bannerId, static_cast<uint32_t>(count) }, {}, false };
+    co_await awaiter;
+    co_return std::move(awaiter.results);
+}
+
+Task<std::optional<GachaResult>> PullScheduler::pull(uint64_t playerId, uint32_t bannerId) {
+    PullAwaiter awaiter{ *this, PullRequest{ playerId, bannerId, 1 }, {}, false };
+    co_await awaiter;
+    if (!awaiter.ok) {
+        co_return std::nullopt;
+    }
+    co_return awaiter.results[0];
+}
@@ -0,0 +1,108 @@
+#ifndef GACHA_PULL_SCHEDULER_H
+#define GACHA_PULL_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "gacha_async.h"
+#include "gacha_server.h"
+#include "gacha_types.h"
+
+// Menggabungkan permintaan pull dari banyak pemain menjadi batch untuk GachaServer::pullBatch().
+// Batch dijalankan begitu jumlah pull yang antre mencapai maxBatch atau permintaan tertua sudah
+// menunggu maxWait (batch besar = throughput tinggi, maxWait kecil = latensi rendah).
+// Permintaan dijalankan sesuai urutan masuk, jadi urutan pity setiap pemain tetap sama persis dengan
+// memanggil server satu per satu. Coroutine yang menunggu dilanjutkan di executor.
+// Scheduler harus dihapus sebelum server dan executor-nya
+class PullScheduler {
+private:
+    // Satu permintaan yang menunggu, menunjuk ke awaiter di frame coroutine pemanggil
+    struct Pending {
+        PullRequest request;
+        std::vector<GachaResult>* results;
+        bool* ok;
+        std::coroutine_handle<> handle;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+    
+    GachaServer& server;
+    GachaExecutor& executor;
+    std::mutex mutex;
+    std::condition_variable ready;      // Ada permintaan baru, batch penuh, pengaturan berubah atau ditutup
+    std::deque<Pending> queue;
+    size_t queuedPulls;                 // Total count permintaan di antrean
+    size_t maxBatch;
+    std::chrono::microseconds maxWait;
+    uint64_t batchCount;
+    bool stopping;
+    
+    // Buffer batch milik thread dispatcher (dipakai ulang antar batch)
+    std::vector<Pending> batch;
+    std::vector<PullRequest> requests;
+    std::vector<GachaResult> results;
+    std::unique_ptr<bool[]> okFlags;
+    size_t okCapacity;
+    
+    std::thread dispatcher;
+    
+    void enqueue(const PullRequest& request, std::vector<GachaResult>* output, bool* ok, std::coroutine_handle<> handle);
+    
+    // Menjalankan satu batch di luar lock lalu membagikan hasilnya ke setiap permintaan
+    void runBatch();
+    
+    void run();
+    
+    // co_await pada satu permintaan
+    struct PullAwaiter {
+        PullScheduler& scheduler;
+        PullRequest request;
+        std::vector<GachaResult> results;
+        bool ok;
+        
+        bool await_ready() const noexcept {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> handle) {
+            scheduler.enqueue(request, &results, &ok, handle);
+        }
+        
+        void await_resume() const noexcept {}
+    };
+
+public:
+    PullScheduler(GachaServer& gachaServer, GachaExecutor& executorValue, size_t maxBatchValue = 4096,
+                  std::chrono::microseconds maxWaitValue = std::chrono::microseconds(200));
+    
+    // Menjalankan semua permintaan yang masih antre lalu menghentikan thread dispatcher
+    ~PullScheduler();
+    
+    PullScheduler(const PullScheduler&) = delete;
+    PullScheduler& operator=(const PullScheduler&) = delete;
+    
+    // Batas jumlah pull per batch (permintaan yang lebih besar tetap dijalankan sendirian)
+    void setMaxBatch(size_t value);
+    
+    // Batas waktu tunggu permintaan tertua sebelum batch yang belum penuh dijalankan
+    void setMaxWait(std::chrono::microseconds value);
+    
+    // Jumlah batch yang sudah dijalankan
+    uint64_t batchesRun();
+    
+    // count pull untuk satu pemain, vector kosong jika ID pemain atau banner tidak dikenal
+    Task<std::vector<GachaResult>> multiPull(uint64_t playerId, uint32_t bannerId, int count);
+    
+    // Satu pull, kosong jika ID pemain atau banner tidak dikenal
+    Task<std::optional<GachaResult>> pull(uint64_t playerId, uint32_t bannerId = 0);
+};
+
+#endif // GACHA_PULL_SCHEDULER_H
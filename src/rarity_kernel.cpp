@@ -0,0 +1,165 @@
+#include "rarity_kernel.h"
+
+#include <cstring>
+#include <vector>
+
+#if !defined(GACHA_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#include <immintrin.h>
+#endif
+
+#if !defined(GACHA_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define GACHA_SIMD_X86 1
+
+#ifdef _MSC_VER
+#define GACHA_TARGET_AVX2
+#else
+#define GACHA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Tabel untuk menyebar 8 bit mask perbandingan menjadi 8 byte (satu byte per pull)
+static const uint64_t* laneSpreadTable() {
+    static const std::vector<uint64_t> table = [] {
+        std::vector<uint64_t> values(256);
+        for (int mask = 0; mask < 256; mask++) {
+            for (int lane = 0; lane < 8; lane++) {
+                if (mask & (1 << lane)) {
+                    values[mask] |= uint64_t(1) << (lane * 8);
+                }
+            }
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+// SSE2: 4 x 2 double per iterasi, 8 pull sekaligus
+static void classifyRaritySSE2(const double* rarityRands, size_t count, const RarityThresholds& threshold,
+                               uint8_t* out) {
+    const uint64_t* spread = laneSpreadTable();
+    __m128d ssr = _mm_set1_pd(threshold.ssr);
+    __m128d sr = _mm_set1_pd(threshold.sr);
+    __m128d r = _mm_set1_pd(threshold.r);
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int masks[3] = { 0, 0, 0 };
+        for (int part = 0; part < 4; part++) {
+            __m128d u = _mm_loadu_pd(rarityRands + i + 2 * part);
+            masks[0] |= _mm_movemask_pd(_mm_cmpge_pd(u, ssr)) << (2 * part);
+            masks[1] |= _mm_movemask_pd(_mm_cmpge_pd(u, sr)) << (2 * part);
+            masks[2] |= _mm_movemask_pd(_mm_cmpge_pd(u, r)) << (2 * part);
+        }
+        uint64_t packed = spread[masks[0]] + spread[masks[1]] + spread[masks[2]];
+        std::memcpy(out + i, &packed, sizeof(packed));
+    }
+    classifyRarityScalar(rarityRands + i, count - i, threshold, out + i);
+}
+
+// AVX2: 2 x 4 double per iterasi, 8 pull sekaligus
+GACHA_TARGET_AVX2 static void classifyRarityAVX2(const double* rarityRands, size_t count,
+                                                 const RarityThresholds& threshold, uint8_t* out) {
+    const uint64_t* spread = laneSpreadTable();
+    __m256d ssr = _mm256_set1_pd(threshold.ssr);
+    __m256d sr = _mm256_set1_pd(threshold.sr);
+    __m256d r = _mm256_set1_pd(threshold.r);
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d low = _mm256_loadu_pd(rarityRands + i);
+        __m256d high = _mm256_loadu_pd(rarityRands + i + 4);
+        int ssrMask = _mm256_movemask_pd(_mm256_cmp_pd(low, ssr, _CMP_GE_OQ)) |
+                      (_mm256_movemask_pd(_mm256_cmp_pd(high, ssr, _CMP_GE_OQ)) << 4);
+        int srMask = _mm256_movemask_pd(_mm256_cmp_pd(low, sr, _CMP_GE_OQ)) |
+                     (_mm256_movemask_pd(_mm256_cmp_pd(high, sr, _CMP_GE_OQ)) << 4);
+        int rMask = _mm256_movemask_pd(_mm256_cmp_pd(low, r, _CMP_GE_OQ)) |
+                    (_mm256_movemask_pd(_mm256_cmp_pd(high, r, _CMP_GE_OQ)) << 4);
+        uint64_t packed = spread[ssrMask] + spread[srMask] + spread[rMask];
+        std::memcpy(out + i, &packed, sizeof(packed));
+    }
+    classifyRarityScalar(rarityRands + i, count - i, threshold, out + i);
+}
+
+static_assert(sizeof(RarityThresholds) == 3 * sizeof(double), "baris tabel batas harus tiga double berurutan");
+
+// SSE2 dengan batas per pull: dua baris tabel dirangkai per register, 8 pull sekaligus
+static void classifyRarityTableSSE2(const double* rarityRands, size_t count, const RarityThresholds* thresholds,
+                                    uint8_t* out) {
+    const uint64_t* spread = laneSpreadTable();
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int masks[3] = { 0, 0, 0 };
+        for (int part = 0; part < 4; part++) {
+            const RarityThresholds& low = thresholds[i + 2 * part];
+            const RarityThresholds& high = thresholds[i + 2 * part + 1];
+            __m128d u = _mm_loadu_pd(rarityRands + i + 2 * part);
+            masks[0] |= _mm_movemask_pd(_mm_cmpge_pd(u, _mm_set_pd(high.ssr, low.ssr))) << (2 * part);
+            masks[1] |= _mm_movemask_pd(_mm_cmpge_pd(u, _mm_set_pd(high.sr, low.sr))) << (2 * part);
+            masks[2] |= _mm_movemask_pd(_mm_cmpge_pd(u, _mm_set_pd(high.r, low.r))) << (2 * part);
+        }
+        uint64_t packed = spread[masks[0]] + spread[masks[1]] + spread[masks[2]];
+        std::memcpy(out + i, &packed, sizeof(packed));
+    }
+    classifyRarityTableScalar(rarityRands + i, count - i, thresholds + i, out + i);
+}
+
+// AVX2 dengan batas per pull: baris tabel diambil dengan gather (jarak 3 double), 8 pull sekaligus
+GACHA_TARGET_AVX2 static void classifyRarityTableAVX2(const double* rarityRands, size_t count,
+                                                      const RarityThresholds* thresholds, uint8_t* out) {
+    const uint64_t* spread = laneSpreadTable();
+    const __m256i rows = _mm256_set_epi64x(9, 6, 3, 0);
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const double* low = &thresholds[i].ssr;
+        const double* high = &thresholds[i + 4].ssr;
+        __m256d lowU = _mm256_loadu_pd(rarityRands + i);
+        __m256d highU = _mm256_loadu_pd(rarityRands + i + 4);
+        int masks[3];
+        for (int column = 0; column < 3; column++) {
+            __m256d lowLimit = _mm256_i64gather_pd(low + column, rows, 8);
+            __m256d highLimit = _mm256_i64gather_pd(high + column, rows, 8);
+            masks[column] = _mm256_movemask_pd(_mm256_cmp_pd(lowU, lowLimit, _CMP_GE_OQ)) |
+                            (_mm256_movemask_pd(_mm256_cmp_pd(highU, highLimit, _CMP_GE_OQ)) << 4);
+        }
+        uint64_t packed = spread[masks[0]] + spread[masks[1]] + spread[masks[2]];
+        std::memcpy(out + i, &packed, sizeof(packed));
+    }
+    classifyRarityTableScalar(rarityRands + i, count - i, thresholds + i, out + i);
+}
+#endif
+
+// Memilih kernel terbaik yang didukung CPU (dipilih sekali)
+void classifyRarityRange(const double* rarityRands, size_t count, const RarityThresholds& threshold,
+                                uint8_t* out) {
+    typedef void (*Kernel)(const double*, size_t, const RarityThresholds&, uint8_t*);
+#ifdef GACHA_SIMD_X86
+#if defined(_MSC_VER) && !defined(__AVX2__)
+    static const Kernel kernel = classifyRaritySSE2;
+#elif defined(_MSC_VER)
+    static const Kernel kernel = classifyRarityAVX2;
+#else
+    static const Kernel kernel = __builtin_cpu_supports("avx2") ? classifyRarityAVX2 : classifyRaritySSE2;
+#endif
+#else
+    static const Kernel kernel = classifyRarityScalar;
+#endif
+    kernel(rarityRands, count, threshold, out);
+}
+
+// Seperti classifyRarityRange(), tetapi setiap pull punya baris batas sendiri
+void classifyRarityTable(const double* rarityRands, size_t count, const RarityThresholds* thresholds, uint8_t* out) {
+    typedef void (*Kernel)(const double*, size_t, const RarityThresholds*, uint8_t*);
+#ifdef GACHA_SIMD_X86
+#if defined(_MSC_VER) && !defined(__AVX2__)
+    static const Kernel kernel = classifyRarityTableSSE2;
+#elif defined(_MSC_VER)
+    static const Kernel kernel = classifyRarityTableAVX2;
+#else
+    static const Kernel kernel = __builtin_cpu_supports("avx2") ? classifyRarityTableAVX2 : classifyRarityTableSSE2;
+#endif
+#else
+    static const Kernel kernel = classifyRarityTableScalar;
+#endif
+    kernel(rarityRands, count, thresholds, out);
+}
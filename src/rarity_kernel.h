@@ -0,0 +1,60 @@
+#ifndef GACHA_RARITY_KERNEL_H
+#define GACHA_RARITY_KERNEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "gacha_types.h"
+
+// Batas kumulatif rarity yang sudah dinormalisasi (SSR, SSR+SR, SSR+SR+R)
+struct RarityThresholds {
+    double ssr;
+    double sr;
+    double r;
+};
+
+// Klasifikasi rarity: jumlah batas yang dilewati angka random (0 = SSR ... 3 = Common).
+// Versi scalar dan SIMD memakai perbandingan yang sama sehingga hasilnya identik
+inline Rarity classifyRarity(double rarityRand, const RarityThresholds& threshold) {
+    return static_cast<Rarity>((rarityRand >= threshold.ssr) + (rarityRand >= threshold.sr) +
+                               (rarityRand >= threshold.r));
+}
+
+inline void classifyRarityScalar(const double* rarityRands, size_t count, const RarityThresholds& threshold,
+                                 uint8_t* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = classifyRarity(rarityRands[i], threshold);
+    }
+}
+
+// Batas berbeda per pull: pull ke-i memakai thresholds[i]
+inline void classifyRarityTableScalar(const double* rarityRands, size_t count, const RarityThresholds* thresholds,
+                                      uint8_t* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = classifyRarity(rarityRands[i], thresholds[i]);
+    }
+}
+
+// Memilih kernel terbaik yang didukung CPU (dipilih sekali, lihat rarity_kernel.cpp)
+void classifyRarityRange(const double* rarityRands, size_t count, const RarityThresholds& threshold, uint8_t* out);
+void classifyRarityTable(const double* rarityRands, size_t count, const RarityThresholds* thresholds, uint8_t* out);
+
+// Klasifikasi spekulatif satu blok pull dengan asumsi counter pity tidak reset di dalam blok.
+// Pull ke-i memakai baris tabel startCounter + i + 1. Baris sebelum soft pity semuanya sama sehingga
+// memakai kernel satu batas; bagian soft pity membaca baris tabel per pull, dan pull setelah baris
+// terakhir (hard pity, diselesaikan resolvePull) memakai baris terakhir
+inline void classifyRarityBlock(const double* rarityRands, size_t count, int startCounter, int softPityStart,
+                                const RarityThresholds* table, size_t tableSize, uint8_t* out) {
+    long long first = static_cast<long long>(startCounter) + 1;
+    size_t split = static_cast<size_t>(std::min<long long>(std::max<long long>(softPityStart - first, 0), count));
+    size_t tableEnd = static_cast<size_t>(std::min<long long>(std::max<long long>(
+        static_cast<long long>(tableSize) - first, static_cast<long long>(split)), count));
+    classifyRarityRange(rarityRands, split, table[std::min<size_t>(first, tableSize - 1)], out);
+    if (tableEnd > split) {
+        classifyRarityTable(rarityRands + split, tableEnd - split, table + first + split, out + split);
+    }
+    classifyRarityRange(rarityRands + tableEnd, count - tableEnd, table[tableSize - 1], out + tableEnd);
+}
+
+#endif // GACHA_RARITY_KERNEL_H
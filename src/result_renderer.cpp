@@ -0,0 +1,145 @@
+#include "result_renderer.h"
+
+#include <charconv>
+#include <utility>
+
+#include "console_color.h"
+
+namespace {
+
+const char* const RARITY_STARS[RARITY_COUNT] = { " ★★★★★", " ★★★★", " ★★★", "" };
+const ConsoleColor RARITY_COLORS[RARITY_COUNT] = { YELLOW, MAGENTA, CYAN, WHITE };
+
+void appendNumber(std::string& buffer, uint64_t value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+// Bagian baris yang sama untuk setiap pull karakter/rarity ini: warna, nama dan rarity
+std::string lineStart(Rarity rarity, bool useColors, const std::string& item) {
+    std::string line = useColors ? ansiColorCode(RARITY_COLORS[rarity]) : "";
+    line += "Item: ";
+    line += item;
+    line += ", Rarity: ";
+    line += rarityName(rarity);
+    line += RARITY_STARS[rarity];
+    return line;
+}
+
+}  // namespace
+
+ResultRenderer::ResultRenderer(const GachaCatalog& catalog, bool useColors) :
+    reset(useColors ? ANSI_RESET : "") {
+    characterLines.reserve(catalog.size());
+    for (uint32_t id = 0; id < catalog.size(); id++) {
+        std::string item = catalog.getName(id);
+        if (!catalog.getTitle(id).empty()) {
+            item += " - " + catalog.getTitle(id);
+        }
+        if (!catalog.getElement(id).empty()) {
+            item += " (" + catalog.getElement(id) + ")";
+        }
+        characterLines.push_back(lineStart(catalog.getRarity(id), useColors, item));
+    }
+    for (int i = 0; i < RARITY_COUNT; i++) {
+        Rarity rarity = static_cast<Rarity>(i);
+        itemLines[i] = lineStart(rarity, useColors, std::string(rarityName(rarity)) + " Item");
+    }
+}
+
+void ResultRenderer::append(const GachaResult& result) {
+    if (result.characterId < characterLines.size()) {
+        buffer += characterLines[result.characterId];
+    } else {
+        buffer += itemLines[result.rarity < RARITY_COUNT ? result.rarity : RARITY_COMMON];
+    }
+    if (result.isPity) {
+        buffer += " (GUARANTEED PITY!)";
+    }
+    buffer += ", Pull #: ";
+    appendNumber(buffer, static_cast<uint64_t>(result.pullNumber));
+    buffer += reset;
+    buffer += '\n';
+}
+
+void ResultRenderer::append(const GachaResult& result, std::string_view label, uint64_t number) {
+    buffer.append(label);
+    appendNumber(buffer, number);
+    buffer += ": ";
+    append(result);
+}
+
+void ResultRenderer::append(const GachaResult* results, size_t count, std::string_view label, uint64_t firstNumber) {
+    for (size_t i = 0; i < count; i++) {
+        if (label.empty()) {
+            append(results[i]);
+        } else {
+            append(results[i], label, firstNumber + i);
+        }
+    }
+}
+
+void ResultRenderer::writeTo(std::ostream& out) {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear();
+}
+
+AsyncResultWriter::AsyncResultWriter(const GachaCatalog& catalog, std::ostream& output, std::string lineLabel,
+                                     bool useColors) :
+    renderer(catalog, useColors),
+    out(output),
+    label(std::move(lineLabel)),
+    busy(false),
+    stopping(false),
+    worker(&AsyncResultWriter::run, this) {}
+
+AsyncResultWriter::~AsyncResultWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    worker.join();
+}
+
+void AsyncResultWriter::submit(const GachaResult* results, size_t count, uint64_t firstNumber) {
+    Batch batch;
+    batch.results.assign(results, results + count);
+    batch.firstNumber = firstNumber;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(batch));
+    }
+    ready.notify_one();
+}
+
+void AsyncResultWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return queue.empty() && !busy; });
+}
+
+// Mengambil satu potongan, memformat dan menulisnya di luar lock; sisa antrean tetap ditulis saat ditutup
+void AsyncResultWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        ready.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        Batch batch = std::move(queue.front());
+        queue.pop_front();
+        busy = true;
+        lock.unlock();
+        
+        renderer.append(batch.results.data(), batch.results.size(), label, batch.firstNumber);
+        renderer.writeTo(out);
+        
+        lock.lock();
+        busy = false;
+        if (queue.empty()) {
+            drained.notify_all();
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef GACHA_RESULT_RENDERER_H
+#define GACHA_RESULT_RENDERER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_types.h"
+
+// Menyusun tampilan hasil pull di buffer yang dipakai ulang lalu menulisnya sekaligus.
+// Teks setiap karakter (nama, title, elemen, rarity dan warnanya) disiapkan sekali di konstruktor,
+// jadi satu baris hasil hanya berupa beberapa append tanpa lookup nama atau flush per baris
+class ResultRenderer {
+private:
+    std::vector<std::string> characterLines;        // Indeks = ID karakter
+    std::string itemLines[RARITY_COUNT];            // Pull tanpa karakter ("SSR Item")
+    const char* reset;                              // Kode reset warna ("" jika tanpa warna)
+    std::string buffer;
+
+public:
+    // useColors = false untuk keluaran tanpa kode ANSI (file atau konsol yang tidak mendukung)
+    explicit ResultRenderer(const GachaCatalog& catalog, bool useColors = true);
+    
+    // Satu baris hasil: "Item: nama - title (elemen), Rarity: SSR ★★★★★, Pull #: n"
+    void append(const GachaResult& result);
+    
+    // Seperti append(result), diawali "label number: "
+    void append(const GachaResult& result, std::string_view label, uint64_t number);
+    
+    // count baris berurutan dengan nomor firstNumber, firstNumber + 1, ...
+    void append(const GachaResult* results, size_t count, std::string_view label, uint64_t firstNumber);
+    
+    void appendText(std::string_view text) {
+        buffer.append(text);
+    }
+    
+    const std::string& str() const {
+        return buffer;
+    }
+    
+    // Mengosongkan buffer (kapasitasnya dipertahankan untuk pemakaian berikutnya)
+    void clear() {
+        buffer.clear();
+    }
+    
+    // Menulis seluruh buffer dengan satu write lalu satu flush, kemudian mengosongkannya
+    void writeTo(std::ostream& out);
+};
+
+// Penulis hasil pull di thread latar: pemanggil hanya menyalin hasil ke antrean, sedangkan
+// format dan penulisan dikerjakan thread sendiri. Urutan keluaran sama dengan urutan submit()
+class AsyncResultWriter {
+private:
+    // Satu potongan hasil dengan nomor baris pertamanya
+    struct Batch {
+        std::vector<GachaResult> results;
+        uint64_t firstNumber;
+    };
+    
+    ResultRenderer renderer;
+    std::ostream& out;
+    std::string label;
+    std::mutex mutex;
+    std::condition_variable ready;      // Ada potongan baru atau writer ditutup
+    std::condition_variable drained;    // Antrean kosong dan tidak ada yang sedang ditulis
+    std::deque<Batch> queue;
+    bool busy;
+    bool stopping;
+    std::thread worker;
+    
+    void run();
+
+public:
+    // Baris diberi awalan "label nomor: " (label kosong = tanpa nomor)
+    AsyncResultWriter(const GachaCatalog& catalog, std::ostream& output, std::string lineLabel = "", bool useColors = true);
+    
+    // Menunggu semua potongan selesai ditulis lalu menghentikan thread
+    ~AsyncResultWriter();
+    
+    AsyncResultWriter(const AsyncResultWriter&) = delete;
+    AsyncResultWriter& operator=(const AsyncResultWriter&) = delete;
+    
+    // Menyalin count hasil ke antrean; nomor baris pertama = firstNumber
+    void submit(const GachaResult* results, size_t count, uint64_t firstNumber = 1);
+    
+    // Menunggu sampai semua yang sudah di-submit selesai ditulis
+    void flush();
+};
+
+#endif // GACHA_RESULT_RENDERER_H
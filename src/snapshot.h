@@ -0,0 +1,260 @@
+#ifndef GACHA_SNAPSHOT_H
+#define GACHA_SNAPSHOT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Format file snapshot biner (versi 5, little-endian native; versi 1-4 masih bisa dibaca):
+// header 24 byte, lalu section berurutan {tipe u32, cadangan u32, ukuran u64, isi}.
+// Isi section dan array di dalamnya selalu rata 8 byte dari awal file, sehingga kolom besar
+// bisa dibaca langsung dari memori hasil mmap tanpa parsing
+const char SNAPSHOT_MAGIC[8] = { 'G', 'A', 'C', 'H', 'A', 'S', 'N', 'P' };
+const uint32_t SNAPSHOT_VERSION = 5;
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304u;  // Terbaca beda jika endianness tidak cocok
+
+enum SnapshotSection : uint32_t {
+    SECTION_CATALOG = 1,   // Pengaturan pity, rate rarity dan daftar karakter
+    SECTION_PLAYERS = 2,   // Kolom state pity semua pemain
+    SECTION_HISTORY = 3,   // Riwayat pull satu pemain beserta counter agregatnya
+    SECTION_BANNERS = 4    // Daftar banner dan jalur pity registry (katalognya section CATALOG berurutan)
+};
+
+// Menulis snapshot ke buffer memori, lalu ke file dengan satu kali tulis
+class SnapshotWriter {
+private:
+    std::vector<char> buffer;
+    size_t sectionStart;   // Posisi header section yang sedang ditulis
+
+public:
+    SnapshotWriter() : sectionStart(0) {
+        putBytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        put<uint32_t>(SNAPSHOT_VERSION);
+        put<uint32_t>(SNAPSHOT_BYTE_ORDER);
+        put<uint32_t>(0);  // Jumlah section, diisi endSection()
+        put<uint32_t>(0);
+    }
+    
+    void putBytes(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+    
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Hanya tipe POD");
+        putBytes(&value, sizeof(T));
+    }
+    
+    // String dengan panjang u32 di depannya
+    void putString(const std::string& value) {
+        put<uint32_t>(static_cast<uint32_t>(value.size()));
+        putBytes(value.data(), value.size());
+    }
+    
+    // Array POD yang rata 8 byte agar bisa dipakai langsung dari mmap
+    template <typename T>
+    void putArray(const T* data, size_t count) {
+        align();
+        putBytes(data, count * sizeof(T));
+    }
+    
+    void align() {
+        buffer.resize((buffer.size() + 7) & ~static_cast<size_t>(7), 0);
+    }
+    
+    // Isi yang sudah ditulis (mis. untuk sidik katalog)
+    const char* bytes() const {
+        return buffer.data();
+    }
+    
+    size_t length() const {
+        return buffer.size();
+    }
+    
+    void beginSection(SnapshotSection type) {
+        align();
+        sectionStart = buffer.size();
+        put<uint32_t>(type);
+        put<uint32_t>(0);
+        put<uint64_t>(0);
+    }
+    
+    void endSection() {
+        align();
+        uint64_t size = buffer.size() - sectionStart - 16;
+        std::memcpy(&buffer[sectionStart + 8], &size, sizeof(size));
+        
+        uint32_t sectionCount;
+        std::memcpy(&sectionCount, &buffer[16], sizeof(sectionCount));
+        sectionCount++;
+        std::memcpy(&buffer[16], &sectionCount, sizeof(sectionCount));
+    }
+    
+    // Ditulis ke file sementara lalu di-rename, jadi snapshot lama tetap utuh jika gagal di tengah
+    bool writeFile(const std::string& path) const {
+        std::string tempPath = path + ".tmp";
+        FILE* file = std::fopen(tempPath.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        bool ok = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        ok = (std::fclose(file) == 0) && ok;
+        if (ok) {
+#ifdef _WIN32
+            std::remove(path.c_str());
+#endif
+            ok = std::rename(tempPath.c_str(), path.c_str()) == 0;
+        }
+        if (!ok) {
+            std::remove(tempPath.c_str());
+        }
+        return ok;
+    }
+};
+
+// File yang dipetakan ke memori (read-only); di Windows isinya dibaca ke buffer biasa
+class MappedFile {
+private:
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    std::vector<uint64_t> storage;   // uint64_t agar buffer rata 8 byte seperti hasil mmap
+#endif
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+    MappedFile() : data(nullptr), size(0) {}
+    
+    ~MappedFile() {
+        close();
+    }
+    
+    // Memetakan seluruh file, false jika file tidak ada atau kosong
+    bool open(const std::string& path);
+    
+    void close();
+    
+    const char* bytes() const {
+        return data;
+    }
+    
+    size_t length() const {
+        return size;
+    }
+};
+
+// Membaca isi satu section; setiap pembacaan dicek batasnya, kegagalan membuat ok() false
+class SnapshotReader {
+private:
+    const char* base;      // Awal file (acuan perataan 8 byte)
+    size_t position;
+    size_t end;
+    uint32_t version;      // Versi format file asal, untuk membaca section lama
+    bool valid;
+
+public:
+    SnapshotReader(const char* fileBase, size_t start, size_t stop, uint32_t fileVersion = SNAPSHOT_VERSION) :
+        base(fileBase), position(start), end(stop), version(fileVersion), valid(true) {}
+    
+    bool ok() const {
+        return valid;
+    }
+    
+    uint32_t getVersion() const {
+        return version;
+    }
+    
+    template <typename T>
+    T get() {
+        T value = T();
+        if (!valid || end - position < sizeof(T)) {
+            valid = false;
+            return value;
+        }
+        std::memcpy(&value, base + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+    
+    std::string getString() {
+        uint32_t length = get<uint32_t>();
+        if (!valid || end - position < length) {
+            valid = false;
+            return std::string();
+        }
+        std::string value(base + position, length);
+        position += length;
+        return value;
+    }
+    
+    // Pointer langsung ke array di dalam file (tanpa salinan)
+    template <typename T>
+    const T* getArray(size_t count) {
+        position = std::min(end, (position + 7) & ~static_cast<size_t>(7));
+        if (!valid || count > (end - position) / sizeof(T)) {
+            valid = false;
+            return nullptr;
+        }
+        const T* array = reinterpret_cast<const T*>(base + position);
+        position += count * sizeof(T);
+        return array;
+    }
+};
+
+// Snapshot yang sudah dipetakan: memeriksa header dan mencari section berdasarkan tipe
+class SnapshotFile {
+private:
+    MappedFile file;
+    uint32_t version = 0;
+    
+    static constexpr size_t HEADER_SIZE = 24;
+    static constexpr size_t SECTION_HEADER_SIZE = 16;
+
+public:
+    // False jika file tidak ada, rusak, atau versinya lebih baru dari yang didukung
+    bool open(const std::string& path) {
+        if (!file.open(path) || file.length() < HEADER_SIZE) {
+            return false;
+        }
+        SnapshotReader header(file.bytes(), 0, HEADER_SIZE);
+        char magic[8];
+        for (char& c : magic) {
+            c = header.get<char>();
+        }
+        version = header.get<uint32_t>();
+        uint32_t byteOrder = header.get<uint32_t>();
+        return std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0 && version >= 1 &&
+               version <= SNAPSHOT_VERSION && byteOrder == SNAPSHOT_BYTE_ORDER;
+    }
+    
+    // Pembaca untuk section ke-occurrence (mulai 0) bertipe tertentu; section yang tidak dikenal dilewati
+    bool findSection(SnapshotSection type, SnapshotReader& out, size_t occurrence = 0) const {
+        size_t position = HEADER_SIZE;
+        while (file.length() - position >= SECTION_HEADER_SIZE) {
+            SnapshotReader header(file.bytes(), position, position + SECTION_HEADER_SIZE);
+            uint32_t sectionType = header.get<uint32_t>();
+            header.get<uint32_t>();
+            uint64_t size = header.get<uint64_t>();
+            position += SECTION_HEADER_SIZE;
+            if (size > file.length() - position) {
+                return false;
+            }
+            if (sectionType == type && occurrence-- == 0) {
+                out = SnapshotReader(file.bytes(), position, position + static_cast<size_t>(size), version);
+                return true;
+            }
+            position += static_cast<size_t>(size);
+        }
+        return false;
+    }
+};
+
+#endif // GACHA_SNAPSHOT_H
@@ -0,0 +1,10 @@
+#ifndef GACHA_ALLOCATION_COUNTER_H
+#define GACHA_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Jumlah panggilan operator new global sejak program mulai. Operator pengganti ada di
+// allocation_counter.cpp (translation unit sendiri agar tidak di-inline ke pemanggil)
+uint64_t allocationCount();
+
+#endif // GACHA_ALLOCATION_COUNTER_H
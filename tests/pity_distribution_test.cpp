@@ -0,0 +1,172 @@
+// Distribusi eksak PityAnalyzer cocok dengan hasil pull() dan GachaSimulator yang disampling.
+// Seed tetap, jadi hasilnya sama di setiap build
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_simulator.h"
+#include "gacha_system.h"
+#include "pity_analyzer.h"
+#include "pull_analytics.h"
+#include "test_support.h"
+
+namespace {
+
+const size_t PULLS = 1 << 21;
+const int WINDOW = 50;
+const double MIN_P_VALUE = 1e-4;
+const uint64_t TARGET_TRIALS = 1 << 17;
+
+// Uji chi-square count terhadap peluang pmf; kategori berurutan digabung sampai harapannya >= 20
+double chiSquareFit(const std::vector<uint64_t>& observed, const std::vector<double>& pmf, uint64_t samples) {
+    double statistic = 0.0;
+    int degrees = -1;
+    double expected = 0.0;
+    double count = 0.0;
+    for (size_t i = 0; i < pmf.size(); i++) {
+        expected += pmf[i] * samples;
+        count += i < observed.size() ? observed[i] : 0;
+        if (expected >= 20.0 || i + 1 == pmf.size()) {
+            if (expected > 0.0) {
+                statistic += (count - expected) * (count - expected) / expected;
+                degrees++;
+            }
+            expected = 0.0;
+            count = 0.0;
+        }
+    }
+    return chiSquarePValue(statistic, degrees);
+}
+
+// Rata-rata sampel dalam 5 simpangan baku dari nilai harapan pmf eksak. pmf yang dipotong (jumlahnya
+// kurang dari 1) dinormalisasi dulu, karena sampel hanya berisi hasil yang masih di dalam batas
+bool meanMatches(double sampleMean, const std::vector<double>& pmf, uint64_t samples) {
+    double total = 0.0;
+    double mean = 0.0;
+    for (size_t n = 0; n < pmf.size(); n++) {
+        total += pmf[n];
+        mean += pmf[n] * n;
+    }
+    mean /= total;
+    double variance = 0.0;
+    for (size_t n = 0; n < pmf.size(); n++) {
+        variance += pmf[n] / total * (n - mean) * (n - mean);
+    }
+    return std::fabs(sampleMean - mean) < 5.0 * std::sqrt(variance / samples);
+}
+
+// Sampel dari pull() satu per satu: nomor pull setiap SSR (pull sejak SSR sebelumnya) dan jumlah SSR
+// di jendela WINDOW pull yang dimulai tepat setelah SSR (jendela tidak tumpang tindih, jadi independen)
+void checkBanner(GachaSystem& gachaSystem, const std::string& name) {
+    gachaSystem.seed(20240611);
+    const GachaCatalog& catalog = gachaSystem.getCatalog();
+    PityAnalyzer analyzer(catalog);
+    PityDistribution exact = analyzer.pullsToSSR();
+    std::vector<double> exactCounts = analyzer.ssrCountDistribution(WINDOW);
+    
+    std::vector<uint64_t> gaps(exact.pmf.size(), 0);
+    std::vector<uint64_t> windowCounts(exactCounts.size(), 0);
+    uint64_t ssrCount = 0;
+    uint64_t windows = 0;
+    double gapSum = 0.0;
+    int windowPulls = -1;   // -1 = menunggu SSR untuk memulai jendela
+    int windowSSR = 0;
+    for (size_t i = 0; i < PULLS; i++) {
+        GachaResult result = gachaSystem.pull();
+        bool ssr = result.rarity == RARITY_SSR;
+        if (windowPulls >= 0) {
+            windowSSR += ssr ? 1 : 0;
+            if (++windowPulls == WINDOW) {
+                windowCounts[static_cast<size_t>(windowSSR)]++;
+                windows++;
+                windowPulls = -1;
+            }
+        }
+        if (ssr) {
+            gaps[static_cast<size_t>(result.pullNumber)]++;
+            gapSum += result.pullNumber;
+            ssrCount++;
+            if (windowPulls < 0) {
+                windowPulls = 0;
+                windowSSR = 0;
+            }
+        }
+    }
+    
+    double sampleMean = gapSum / ssrCount;
+    check(meanMatches(sampleMean, exact.pmf, ssrCount),
+          name + ": rata-rata pull sampai SSR " + std::to_string(sampleMean) + " vs " + std::to_string(exact.expected()));
+    
+    double total = 0.0;
+    for (double p : exact.pmf) {
+        total += p;
+    }
+    check(std::fabs(total - 1.0) < 1e-12 && exact.percentile(1.0) <= catalog.getHardPity(),
+          name + ": pmf berjumlah 1 dan berhenti di hard pity");
+    check(chiSquareFit(gaps, exact.pmf, ssrCount) > MIN_P_VALUE, name + ": chi-square pull sampai SSR");
+    check(chiSquareFit(windowCounts, exactCounts, windows) > MIN_P_VALUE,
+          name + ": chi-square jumlah SSR dalam " + std::to_string(WINDOW) + " pull");
+}
+
+// Banner rate-up: PityAnalyzer::pullsToTarget() (angka "eksak" di menu simulasi) dibandingkan dengan
+// histogram pullsToTarget GachaSimulator untuk karakter pilihan dan karakter featured lain
+void checkTarget(const GachaCatalog& catalog, uint32_t target, uint32_t selected, const std::string& name) {
+    SimulationConfig config;
+    config.trials = TARGET_TRIALS;
+    config.seed = 20240611;
+    config.threads = 1;
+    config.targetCharacterId = target;
+    config.pityCharacterId = selected;
+    SimulationResult simulation = GachaSimulator(catalog).run(config);
+    PityDistribution exact = PityAnalyzer(catalog).pullsToTarget(target, selected, 0, 0, config.maxPullsPerTrial);
+    
+    double sampleMean = SimulationResult::mean(simulation.pullsToTarget);
+    check(meanMatches(sampleMean, exact.pmf, config.trials - simulation.targetNotReached),
+          name + ": rata-rata pull sampai target " + std::to_string(sampleMean));
+    
+    // Trajectory yang belum mendapat target sampai batas menjadi kategori terakhir (sisa peluang pmf)
+    std::vector<uint64_t> observed = simulation.pullsToTarget;
+    std::vector<double> expected = exact.pmf;
+    double reached = 0.0;
+    for (double p : expected) {
+        reached += p;
+    }
+    observed.push_back(simulation.targetNotReached);
+    expected.push_back(std::max(0.0, 1.0 - reached));
+    check(chiSquareFit(observed, expected, config.trials) > MIN_P_VALUE, name + ": chi-square pull sampai target");
+}
+
+}  // namespace
+
+int main() {
+    GachaSystem multiply;
+    addTestCharacters(multiply);
+    multiply.setPitySettings(90, 75, 5.0);
+    checkBanner(multiply, "soft pity x5");
+    
+    GachaSystem linear;
+    addTestCharacters(linear);
+    linear.setPitySettings(80, 65, SoftPityCurve::linear(0.06));
+    checkBanner(linear, "soft pity linear");
+    
+    GachaSystem shortPity;
+    addTestCharacters(shortPity);
+    shortPity.setPitySettings(20, 10, 3.0);
+    checkBanner(shortPity, "hard pity 20");
+    
+    // Rate-up dengan 50/50, capture dan fate point; karakter 0 dan 4 featured, 4 dipilih
+    GachaCatalog featured = linear.getCatalog();
+    FeaturedRules rules;
+    rules.captureStreak = 2;
+    rules.fatePoints = 2;
+    check(featured.setFeatured({ 0, 4 }, rules), "rate-up: setFeatured");
+    featured.compile();
+    checkTarget(featured, 4, 4, "rate-up karakter pilihan");
+    checkTarget(featured, 0, 4, "rate-up featured lain");
+    return testExitCode();
+}
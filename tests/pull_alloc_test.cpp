@@ -0,0 +1,117 @@
+// Pull dalam keadaan stabil tidak memanggil allocator sama sekali.
+// operator new global diganti dengan penghitung (allocation_counter.cpp)
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "gacha_catalog.h"
+#include "gacha_server.h"
+#include "gacha_system.h"
+#include "pull_history.h"
+#include "test_support.h"
+
+namespace {
+
+const size_t PULLS = 1 << 18;
+
+uint64_t sink = 0;
+
+// Jumlah alokasi harus paling banyak limit
+void checkAllocations(uint64_t allocations, uint64_t limit, const std::string& name) {
+    check(allocations <= limit, name + ": " + std::to_string(allocations) + " alokasi (batas " +
+                                std::to_string(limit) + ")");
+}
+
+// Banner uji bersama dengan seed tetap
+void setUp(GachaSystem& gachaSystem) {
+    addTestCharacters(gachaSystem);
+    gachaSystem.seed(2024);
+}
+
+// Alokasi selama pulls pull lewat pull() (batch 1) atau pullBatch(batch)
+uint64_t countAllocations(GachaSystem& gachaSystem, size_t batch, GachaResult* buffer) {
+    uint64_t before = allocationCount();
+    for (size_t done = 0; done < PULLS; done += batch) {
+        if (batch == 1) {
+            sink += gachaSystem.pull().characterId;
+        } else {
+            gachaSystem.pullBatch(buffer, batch);
+            sink += buffer[0].characterId;
+        }
+    }
+    return allocationCount() - before;
+}
+
+// Ring buffer yang sudah penuh: setiap pull menimpa entri tertua, nol alokasi
+void checkRingBuffer(size_t batch, const std::string& name) {
+    GachaSystem gachaSystem;
+    setUp(gachaSystem);
+    std::vector<GachaResult> buffer(256);
+    gachaSystem.setHistoryLimit(1 << 16);
+    for (size_t done = 0; done < (1 << 17); done += buffer.size()) {
+        gachaSystem.pullBatch(buffer.data(), buffer.size());
+    }
+    uint64_t allocations = countAllocations(gachaSystem, batch, buffer.data());
+    checkAllocations(allocations, 0, name);
+}
+
+// Riwayat yang sudah disiapkan lewat reserveHistory(): nol alokasi sampai batas itu
+void checkReserved(size_t batch, const std::string& name) {
+    GachaSystem gachaSystem;
+    setUp(gachaSystem);
+    std::vector<GachaResult> buffer(256);
+    gachaSystem.pullBatch(buffer.data(), buffer.size());
+    gachaSystem.reserveHistory(PULLS);
+    uint64_t allocations = countAllocations(gachaSystem, batch, buffer.data());
+    checkAllocations(allocations, 0, name);
+}
+
+// Riwayat tanpa batas: hanya chunk baru (plus peta deque-nya sesekali), tidak pernah per pull
+void checkUnbounded() {
+    GachaSystem gachaSystem;
+    setUp(gachaSystem);
+    std::vector<GachaResult> buffer(256);
+    gachaSystem.pullBatch(buffer.data(), buffer.size());
+    uint64_t allocations = countAllocations(gachaSystem, 1, buffer.data());
+    uint64_t limit = 2 * (PULLS / PullHistory::CHUNK_SIZE + 1);
+    checkAllocations(allocations, limit, "pull() riwayat tanpa batas");
+}
+
+// Server tanpa catatan pull: state pemain di kolom shard yang tidak pernah tumbuh saat pull
+void checkServer() {
+    std::shared_ptr<GachaCatalog> catalog = std::make_shared<GachaCatalog>();
+    addTestCharacters(*catalog);
+    catalog->compile();
+    GachaServer server(std::shared_ptr<const GachaCatalog>(catalog), 2024, 8);
+    const uint64_t players = 1024;
+    server.addPlayers(players);
+    GachaResult results[16];
+    for (uint64_t player = 0; player < players; player++) {
+        server.pull(player, results, 16);
+    }
+    
+    uint64_t before = allocationCount();
+    for (size_t done = 0; done < PULLS; done += 16) {
+        server.pull((done / 16) % players, results, 16);
+        sink += results[0].characterId;
+    }
+    uint64_t allocations = allocationCount() - before;
+    checkAllocations(allocations, 0, "GachaServer::pull()");
+}
+
+}  // namespace
+
+int main() {
+    checkRingBuffer(1, "pull() ring buffer penuh");
+    checkRingBuffer(256, "pullBatch(256) ring buffer penuh");
+    checkReserved(1, "pull() setelah reserveHistory()");
+    checkReserved(256, "pullBatch(256) setelah reserveHistory()");
+    checkUnbounded();
+    checkServer();
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(sink));
+    return testExitCode();
+}
@@ -0,0 +1,117 @@
+// Catatan pull yang terpotong di tengah record (crash saat append) tetap bisa dilanjutkan: server baru
+// memutar ulang catatannya, membukanya lagi dan menambah pull, lalu records() dan verifier melihat
+// catatan yang bersih tanpa record rusak
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_server.h"
+#include "pull_audit.h"
+#include "pull_log.h"
+#include "snapshot.h"
+#include "test_support.h"
+
+namespace {
+
+const uint64_t SEED = 2024;
+const uint64_t PLAYERS = 64;
+const size_t ROUNDS = 40;
+const size_t PULLS_PER_ROUND = 3;
+
+// Pull bergiliran untuk semua pemain, agar record pemain yang berbeda saling berselang di catatan
+void pullRounds(GachaServer& server, size_t rounds) {
+    GachaResult results[PULLS_PER_ROUND];
+    for (size_t round = 0; round < rounds; round++) {
+        for (uint64_t player = 0; player < PLAYERS; player++) {
+            server.pull(player, results, PULLS_PER_ROUND);
+        }
+    }
+}
+
+// Jumlah record utuh di catatan, 0 jika bukan catatan pull
+size_t recordCount(const std::string& path) {
+    MappedFile mapped;
+    const PullLogRecord* records = nullptr;
+    size_t count = 0;
+    std::vector<PullLogRecord> converted;
+    if (!mapped.open(path) || !PullLog::records(mapped, records, count, converted)) {
+        return 0;
+    }
+    return count;
+}
+
+void checkTornTail(std::shared_ptr<const GachaCatalog> catalog, const std::string& path) {
+    std::remove(path.c_str());
+    {
+        GachaServer server(catalog, SEED, 8);
+        server.addPlayers(PLAYERS);
+        PullLog log;
+        check(log.open(path, SEED) && server.setPullLog(&log), "catatan baru dibuka");
+        pullRounds(server, ROUNDS);
+        server.setPullLog(nullptr);
+    }
+    
+    // Crash saat menulis: record terakhir hanya tertulis sebagian
+    size_t written = recordCount(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 13);
+    check(recordCount(path) == written - 1, "record terpotong diabaikan records()");
+    
+    GachaServer server(catalog, SEED, 8);
+    server.addPlayers(PLAYERS);
+    check(server.replayLog(path), "catatan terpotong diputar ulang");
+    PullLog log;
+    check(log.open(path, SEED) && server.setPullLog(&log), "catatan terpotong dibuka lagi");
+    check(std::filesystem::file_size(path) == PullLog::HEADER_SIZE + (written - 1) * sizeof(PullLogRecord),
+          "sisa record terpotong dibuang saat dibuka");
+    pullRounds(server, ROUNDS);
+    server.setPullLog(nullptr);
+    log.close();
+    
+    size_t expected = written - 1 + ROUNDS * PLAYERS * PULLS_PER_ROUND;
+    check(recordCount(path) == expected, "record setelah dibuka lagi terbaca utuh");
+    
+    PullLogVerifier verifier;
+    verifier.addCatalog(0, catalog);
+    for (unsigned threads : { 1u, 3u }) {
+        AuditReport report;
+        bool read = verifier.verifyFile(path, report, threads);
+        check(read && report.clean() && report.records == expected && report.players == PLAYERS,
+              "verifier bersih dengan " + std::to_string(threads) + " thread: " +
+              std::to_string(report.divergenceCount()) + " ketidakcocokan");
+    }
+}
+
+// File yang baru berisi sebagian header dibuat ulang, bukan ditolak selamanya
+void checkTornHeader(const std::string& path) {
+    char header[PullLog::HEADER_SIZE];
+    PullLog::writeHeader(header, SEED, RNG_PHILOX4X32);
+    FILE* file = std::fopen(path.c_str(), "wb");
+    std::fwrite(header, 1, 20, file);
+    std::fclose(file);
+    
+    PullLog log;
+    check(log.open(path, SEED), "header terpotong dibuat ulang");
+    log.close();
+    check(std::filesystem::file_size(path) == PullLog::HEADER_SIZE && recordCount(path) == 0,
+          "header baru tanpa record");
+}
+
+}  // namespace
+
+int main() {
+    std::shared_ptr<GachaCatalog> catalog = std::make_shared<GachaCatalog>();
+    addTestCharacters(*catalog);
+    catalog->setPitySettings(20, 10, 3.0);
+    catalog->compile();
+    
+    std::string path = (std::filesystem::temp_directory_path() / "gacha_pull_log_test.log").string();
+    checkTornTail(catalog, path);
+    checkTornHeader(path);
+    std::remove(path.c_str());
+    return testExitCode();
+}
@@ -0,0 +1,164 @@
+// Kernel rarity yang dipilih saat runtime (SIMD jika didukung CPU) identik bit per bit dengan versi
+// scalar, dan resolveBatch() identik dengan resolvePull() satu per satu termasuk saat counter pity
+// reset di tengah jendela
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gacha_catalog.h"
+#include "gacha_system.h"
+#include "rarity_kernel.h"
+#include "test_support.h"
+
+namespace {
+
+// Angka random untuk kernel: sebagian tepat di batas atau satu ulp di sekitarnya, agar perbedaan
+// perbandingan (>= vs >) antara SIMD dan scalar langsung terlihat
+std::vector<double> kernelInputs(const std::vector<RarityThresholds>& table, size_t count, std::mt19937_64& engine) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<size_t> pick(0, table.size() - 1);
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; i++) {
+        const RarityThresholds& row = table[pick(engine)];
+        double limits[3] = { row.ssr, row.sr, row.r };
+        double limit = limits[engine() % 3];
+        switch (engine() % 6) {
+            case 0: values[i] = limit; break;
+            case 1: values[i] = std::nextafter(limit, 0.0); break;
+            case 2: values[i] = std::nextafter(limit, 1.0); break;
+            case 3: values[i] = (engine() & 1) ? 0.0 : std::nextafter(1.0, 0.0); break;
+            default: values[i] = uniform(engine); break;
+        }
+    }
+    return values;
+}
+
+// Semua panjang 0..70 (ekor scalar setiap kernel) dan offset awal tabel yang berbeda-beda
+void checkKernels(GachaSystem& gachaSystem, const std::string& name) {
+    const GachaCatalog& catalog = gachaSystem.getCatalog();
+    std::vector<RarityThresholds> table;
+    for (int counter = 0; counter <= catalog.getHardPity(); counter++) {
+        table.push_back(catalog.getThresholdsAt(counter));
+    }
+    
+    std::mt19937_64 engine(20240611);
+    std::vector<double> values = kernelInputs(table, 4096, engine);
+    std::vector<uint8_t> expected(values.size());
+    std::vector<uint8_t> actual(values.size());
+    bool rangeSame = true;
+    bool tableSame = true;
+    bool blockSame = true;
+    for (size_t count = 0; count <= 70; count++) {
+        size_t offset = (count * 37) % (values.size() - count);
+        for (const RarityThresholds& row : table) {
+            classifyRarityScalar(values.data() + offset, count, row, expected.data());
+            classifyRarityRange(values.data() + offset, count, row, actual.data());
+            rangeSame = rangeSame && std::equal(expected.begin(), expected.begin() + count, actual.begin());
+        }
+        
+        std::vector<RarityThresholds> rows(count);
+        for (size_t i = 0; i < count; i++) {
+            rows[i] = table[(offset + i * 7) % table.size()];
+        }
+        classifyRarityTableScalar(values.data() + offset, count, rows.data(), expected.data());
+        classifyRarityTable(values.data() + offset, count, rows.data(), actual.data());
+        tableSame = tableSame && std::equal(expected.begin(), expected.begin() + count, actual.begin());
+        
+        // Referensi classifyRarityBlock(): pull ke-i memakai baris startCounter + i + 1 (paling jauh baris terakhir)
+        for (int start = 0; start < static_cast<int>(table.size()); start++) {
+            for (size_t i = 0; i < count; i++) {
+                size_t row = std::min<size_t>(static_cast<size_t>(start) + i + 1, table.size() - 1);
+                expected[i] = classifyRarity(values[offset + i], table[row]);
+            }
+            classifyRarityBlock(values.data() + offset, count, start, catalog.getSoftPityStart(), table.data(),
+                                table.size(), actual.data());
+            blockSame = blockSame && std::equal(expected.begin(), expected.begin() + count, actual.begin());
+        }
+    }
+    check(rangeSame, name + ": classifyRarityRange sama dengan scalar");
+    check(tableSame, name + ": classifyRarityTable sama dengan scalar");
+    check(blockSame, name + ": classifyRarityBlock sama dengan batas per pull");
+}
+
+bool sameResult(const GachaResult& a, const GachaResult& b) {
+    return a.characterId == b.characterId && a.rarity == b.rarity && a.isPity == b.isPity &&
+           a.bannerId == b.bannerId && a.pullNumber == b.pullNumber;
+}
+
+bool sameState(const PityState& a, const PityState& b) {
+    return a.pullCount == b.pullCount && a.selectedCharPity == b.selectedCharPity &&
+           a.featuredState == b.featuredState;
+}
+
+// resolveBatch() dengan berbagai panjang batch dan counter awal dibandingkan dengan resolvePull().
+// Sebagian angka rarity dibuat kecil agar SSR (reset counter) sering terjadi di tengah jendela
+void checkBatch(const GachaCatalog& catalog, const std::string& name) {
+    std::mt19937_64 engine(7);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const size_t pulls = 20000;
+    std::vector<double> uniforms(2 * pulls);
+    for (size_t i = 0; i < pulls; i++) {
+        uniforms[2 * i] = (engine() % 16 == 0) ? uniform(engine) * catalog.getThresholdsAt(1).ssr : uniform(engine);
+        uniforms[2 * i + 1] = uniform(engine);
+    }
+    
+    bool same = true;
+    size_t resets = 0;
+    const size_t lengths[] = { 1, 7, 31, 32, 33, 100, 257 };
+    for (size_t length : lengths) {
+        for (int start = 0; start < catalog.getHardPity(); start += 3) {
+            PityState single = { start, 0, 0 };
+            PityState batched = single;
+            std::vector<GachaResult> results(length);
+            for (size_t done = 0; done + length <= pulls && same; done += length) {
+                catalog.resolveBatch(batched, uniforms.data() + 2 * done, length, results.data());
+                for (size_t i = 0; i < length; i++) {
+                    GachaResult expected = catalog.resolvePull(single, uniforms[2 * (done + i)],
+                                                               uniforms[2 * (done + i) + 1]);
+                    same = same && sameResult(expected, results[i]);
+                    resets += single.pullCount == 0 && i + 1 < length ? 1 : 0;
+                }
+                same = same && sameState(single, batched);
+            }
+        }
+    }
+    check(same, name + ": resolveBatch sama dengan resolvePull");
+    check(resets > 0, name + ": ada reset pity di tengah batch");
+}
+
+} // namespace
+
+int main() {
+    GachaSystem standard;
+    addTestCharacters(standard);
+    standard.setPitySettings(90, 75, 5.0);
+    checkKernels(standard, "soft pity x5");
+    checkBatch(standard.getCatalog(), "soft pity x5");
+    
+    GachaSystem linear;
+    addTestCharacters(linear);
+    linear.setPitySettings(80, 65, SoftPityCurve::linear(0.06));
+    checkKernels(linear, "soft pity linear");
+    checkBatch(linear.getCatalog(), "soft pity linear");
+    
+    // Banner rate-up: SSR di dalam batch juga menggerakkan mesin state featured
+    GachaCatalog featured = linear.getCatalog();
+    FeaturedRules rules;
+    rules.captureStreak = 2;
+    rules.fatePoints = 2;
+    check(featured.setFeatured({ 0, 4 }, rules), "rate-up: setFeatured");
+    featured.compile();
+    checkBatch(featured, "rate-up");
+    
+    GachaSystem shortPity;
+    addTestCharacters(shortPity);
+    shortPity.setPitySettings(20, 10, 3.0);
+    checkKernels(shortPity, "hard pity 20");
+    checkBatch(shortPity.getCatalog(), "hard pity 20");
+    
+    return testExitCode();
+}
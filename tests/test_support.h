@@ -0,0 +1,35 @@
+#ifndef GACHA_TEST_SUPPORT_H
+#define GACHA_TEST_SUPPORT_H
+
+// Pembantu bersama untuk tes ctest. Setiap tes adalah program biasa yang mencetak satu baris per
+// pemeriksaan lewat check() dan mengembalikan testExitCode() dari main (1 jika ada yang gagal)
+#include <cstdio>
+#include <string>
+
+#include "gacha_types.h"
+
+inline int testFailures = 0;
+
+// Mencetak nama pemeriksaan beserta hasilnya dan mencatat kegagalan
+inline void check(bool condition, const std::string& name) {
+    std::printf("%-60s %s\n", name.c_str(), condition ? "ok" : "GAGAL");
+    if (!condition) {
+        testFailures++;
+    }
+}
+
+inline int testExitCode() {
+    return testFailures == 0 ? 0 : 1;
+}
+
+// Banner uji kecil tanpa file konfigurasi: 16 karakter, rarity bergantian SSR, SR, R, R.
+// Dipakai untuk GachaSystem maupun GachaCatalog (keduanya punya addCharacter(nama, rarity, rate))
+template <typename Banner>
+void addTestCharacters(Banner& banner) {
+    const Rarity rarities[] = { RARITY_SSR, RARITY_SR, RARITY_R, RARITY_R };
+    for (int i = 0; i < 16; i++) {
+        banner.addCharacter("Char" + std::to_string(i), rarities[i % 4], 0.001 + (i % 5) * 0.001);
+    }
+}
+
+#endif // GACHA_TEST_SUPPORT_H